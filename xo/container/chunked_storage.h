@@ -0,0 +1,204 @@
+#pragma once
+
+#include "xo/xo_types.h"
+#include "xo/system/assert.h"
+#include "xo/container/label_vector.h"
+#include "xo/container/storage.h"
+#include "xo/numerical/math.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <ostream>
+
+namespace xo
+{
+	/// append-only storage class that stores each channel in fixed-size chunks of ChunkSize frames.
+	/// adding frames never moves existing data and adding a channel does not copy existing channels.
+	/// has the same frame / channel interface as storage, use make_storage to convert.
+	template< typename T, typename L = std::string, size_t ChunkSize = 4096 >
+	class chunked_storage
+	{
+	public:
+		static_assert( ChunkSize > 0 && ( ChunkSize & ( ChunkSize - 1 ) ) == 0, "ChunkSize must be a power of two" );
+		using value_type = T;
+		using label_type = L;
+		using chunk_type = std::unique_ptr< T[] >;
+
+		struct const_frame {
+			const_frame( const chunked_storage& s, index_t f ) : sto_( s ), fidx_( f ) {}
+			const T& operator[]( index_t i ) const { return sto_( fidx_, i ); }
+			const T& operator[]( const L& l ) const { return sto_( fidx_, sto_.find_channel( l ) ); }
+			const chunked_storage& sto_;
+			index_t fidx_;
+		};
+
+		struct frame {
+			frame( chunked_storage& s, index_t f ) : sto_( s ), fidx_( f ) {}
+			T& operator[]( index_t i ) const { return sto_( fidx_, i ); }
+			T& operator[]( const L& l ) const { return sto_( fidx_, sto_.find_or_add_channel( l ) ); }
+			chunked_storage& sto_;
+			index_t fidx_;
+		};
+
+		chunked_storage( size_t frames = 0, size_t channels = 0, T value = T() ) : frame_size_( 0 ), labels_( 0 ) {
+			resize( frames, channels, value );
+		}
+
+		/// add a channel, existing channels are not touched
+		index_t add_channel( L label, const T& value = T() ) {
+			add_channel_chunks( value );
+			labels_.resize( channel_size() + 1 );
+			return labels_.set( channel_size() - 1, label );
+		}
+
+		/// add a channel with data, adds frames if needed
+		index_t add_channel( L label, const std::vector< T >& data ) {
+			auto cidx = add_channel( label );
+			if ( std::size( data ) > frame_size() )
+				resize( std::size( data ), channel_size() );
+			for ( index_t fidx = 0; fidx < std::size( data ); ++fidx )
+				( *this )( fidx, cidx ) = data[ fidx ];
+			return cidx;
+		}
+
+		/// find index of a label
+		index_t find_channel( const L& label ) const { return labels_.find_or_throw( label ); }
+
+		/// find index of a label
+		index_t try_find_channel( const L& label ) const { return labels_.find( label ); }
+
+		/// find or add a channel
+		index_t find_or_add_channel( const L& label, const T& value = T() ) {
+			auto idx = labels_.find( label );
+			return idx == no_index ? add_channel( label, value ) : idx;
+		}
+
+		/// set channel label
+		void set_label( index_t channel, L label ) { labels_.set( channel, label ); }
+
+		/// get channel label
+		const L& get_label( index_t channel ) const { return labels_[ channel ]; }
+
+		/// add frame to storage, allocates a new chunk per channel every ChunkSize frames
+		frame add_frame( T value = T( 0 ) ) {
+			if ( frame_size_ % ChunkSize == 0 )
+				for ( auto& ch : chunks_ )
+					ch.push_back( chunk_type( new T[ ChunkSize ] ) );
+			++frame_size_;
+			for ( index_t ci = 0; ci < channel_size(); ++ci )
+				( *this )( frame_size_ - 1, ci ) = value;
+			return back();
+		}
+
+		/// add frame to storage
+		frame add_frame( const std::vector< T >& data ) {
+			xo_assert( std::size( data ) == channel_size() );
+			auto f = add_frame();
+			for ( index_t ci = 0; ci < channel_size(); ++ci )
+				f[ ci ] = data[ ci ];
+			return f;
+		}
+
+		/// number of channels
+		size_t channel_size() const { return labels_.size(); }
+
+		/// number of frames in storage
+		size_t frame_size() const { return frame_size_; }
+
+		/// check if there is any data
+		bool empty() const { return frame_size_ == 0 || channel_size() == 0; }
+
+		/// clear the storage
+		void clear() { frame_size_ = 0; labels_.clear(); chunks_.clear(); }
+
+		/// access value (no bounds checking)
+		const T& operator()( index_t frame, index_t channel ) const { return chunks_[ channel ][ frame / ChunkSize ][ frame % ChunkSize ]; }
+		T& operator()( index_t frame, index_t channel ) { return chunks_[ channel ][ frame / ChunkSize ][ frame % ChunkSize ]; }
+
+		/// number of chunks per channel
+		size_t chunk_count() const { return ( frame_size_ + ChunkSize - 1 ) / ChunkSize; }
+
+		/// contiguous data of chunk ci of a channel, the last chunk may contain fewer than ChunkSize frames
+		const T* chunk_data( index_t channel, index_t chunk ) const { return chunks_[ channel ][ chunk ].get(); }
+		T* chunk_data( index_t channel, index_t chunk ) { return chunks_[ channel ][ chunk ].get(); }
+
+		/// access frame
+		const_frame operator[]( index_t f ) const { return const_frame( *this, f ); }
+		frame operator[]( index_t f ) { return frame( *this, f ); }
+		const_frame front() const { return const_frame( *this, 0 ); }
+		frame front() { return frame( *this, 0 ); }
+		const_frame back() const { return const_frame( *this, frame_size() - 1 ); }
+		frame back() { return frame( *this, frame_size() - 1 ); }
+
+		/// get the interpolated value of a specific frame / channel
+		T get_interpolated_value( T frame_idx, index_t channel ) const {
+			auto frame_f = floor( frame_idx );
+			auto frame_w = frame_idx - frame_f;
+			index_t frame0 = static_cast<index_t>( frame_f );
+			xo_assert( frame0 + 1 < frame_size() );
+			return ( T( 1 ) - frame_w ) * ( *this )( frame0, channel ) + frame_w * ( *this )( frame0 + 1, channel );
+		}
+
+		void resize( size_t nframes, size_t nchannels, T value = T() ) {
+			xo_error_if( nframes < frame_size() || nchannels < channel_size(), "Cannot shrink storage" );
+			while ( frame_size() < nframes )
+				add_frame( value );
+			while ( channel_size() < nchannels ) {
+				add_channel_chunks( value );
+				labels_.resize( channel_size() + 1 );
+			}
+		}
+
+		std::vector<T> get_channel( index_t channel ) const {
+			std::vector<T> vec;
+			vec.reserve( frame_size() );
+			for ( index_t ci = 0; ci < chunk_count(); ++ci ) {
+				auto* d = chunk_data( channel, ci );
+				vec.insert( vec.end(), d, d + min( ChunkSize, frame_size() - ci * ChunkSize ) );
+			}
+			return vec;
+		}
+		std::vector<T> get_channel( const L& label ) const { return get_channel( find_channel( label ) ); }
+
+		const label_vector< L >& labels() const { return labels_; }
+
+	private:
+		void add_channel_chunks( const T& value ) {
+			auto& ch = chunks_.emplace_back();
+			for ( index_t ci = 0; ci < chunk_count(); ++ci ) {
+				ch.push_back( chunk_type( new T[ ChunkSize ] ) );
+				std::fill( ch.back().get(), ch.back().get() + ChunkSize, value );
+			}
+		}
+
+		size_t frame_size_;
+		label_vector< L > labels_;
+		std::vector< std::vector< chunk_type > > chunks_; // chunks per channel
+	};
+
+	/// convert chunked_storage to storage
+	template< typename T, typename L, size_t C > storage< T, L > make_storage( const chunked_storage< T, L, C >& cs ) {
+		storage< T, L > sto( cs.frame_size(), cs.channel_size() );
+		for ( index_t ci = 0; ci < cs.channel_size(); ++ci ) {
+			sto.set_label( ci, cs.get_label( ci ) );
+			for ( index_t fi = 0; fi < cs.frame_size(); ++fi )
+				sto( fi, ci ) = cs( fi, ci );
+		}
+		return sto;
+	}
+
+	template< typename T, typename L, size_t C > std::ostream& operator<<( std::ostream& str, const chunked_storage< T, L, C >& buf ) {
+		for ( index_t ci = 0; ci < buf.channel_size(); ++ci ) {
+			str << buf.get_label( ci );
+			if ( ci == buf.channel_size() - 1 ) str << std::endl; else str << '\t';
+		}
+		for ( index_t fi = 0; fi < buf.frame_size(); ++fi ) {
+			for ( index_t ci = 0; ci < buf.channel_size(); ++ci ) {
+				str << buf( fi, ci );
+				if ( ci == buf.channel_size() - 1 ) str << std::endl; else str << '\t';
+			}
+		}
+		return str;
+	}
+}
@@ -2,37 +2,65 @@
 
 #include "xo/xo_types.h"
 #include "xo/system/assert.h"
+#include "xo/numerical/math.h"
+#include <algorithm>
+#include <utility>
 #include <vector>
 
 namespace xo
 {
+	/// contiguous segment of a ring buffer, ring contents are accessed as a pair of segments
 	template< typename T >
+	struct ring_segment
+	{
+		T* data;
+		size_t size;
+		T* begin() const { return data; }
+		T* end() const { return data + size; }
+		bool empty() const { return size == 0; }
+	};
+
+	/// wrap index into [0, capacity), capacity must be a power of two if PowerOfTwo is true
+	template< bool PowerOfTwo > size_t ring_index( size_t idx, size_t capacity ) {
+		if constexpr ( PowerOfTwo )
+			return idx & ( capacity - 1 );
+		else return idx < capacity ? idx : ( idx < 2 * capacity ? idx - capacity : idx % capacity );
+	}
+
+	/// double-ended queue stored in a ring buffer, grows by re-linearizing its contents
+	/// if PowerOfTwo is true, capacity is rounded up to a power of two and indices are masked instead of using modulo
+	template< typename T, bool PowerOfTwo = false >
 	class circular_deque
 	{
 	public:
 		using value_type = T;
 		using buffer_type = std::vector< T >;
+		using segment = ring_segment< T >;
+		using const_segment = ring_segment< const T >;
 
-		circular_deque( size_t init_capacity = 0 ) : front_( 0 ), size_( 0 ), buffer_( init_capacity ) {}
+		circular_deque( size_t init_capacity = 0 ) : front_( 0 ), size_( 0 ), buffer_( valid_capacity( init_capacity ) ) {}
 		~circular_deque() {}
 
 		void push_back( const T& value ) {
-			if ( ++size_ > capacity() ) buffer_.insert( buffer_.begin() + ( front_ + size_ - 1 ), value );
-			else back() = value;
+			if ( full() ) grow( size_ + 1 );
+			buffer_[ wrap( front_ + size_ ) ] = value;
+			++size_;
 		}
 		void push_front( const T& value ) {
-			if ( ++size_ > capacity() ) buffer_.insert( buffer_.begin() + front_, value );
-			else { front_ = ( front_ + capacity() - 1 ) % capacity(); front() = value; }
+			if ( full() ) grow( size_ + 1 );
+			front_ = wrap( front_ + capacity() - 1 );
+			buffer_[ front_ ] = value;
+			++size_;
 		}
 
-		T& operator[]( index_t idx ) { return buffer_[ ( front_ + idx ) % buffer_.size() ]; }
-		const T& operator[]( index_t idx ) const { return buffer_[ ( front_ + idx ) % buffer_.size() ]; }
+		T& operator[]( index_t idx ) { return buffer_[ wrap( front_ + idx ) ]; }
+		const T& operator[]( index_t idx ) const { return buffer_[ wrap( front_ + idx ) ]; }
 
 		void pop_back() { xo_assert( size_ > 0 ); --size_; }
-		void pop_front() { xo_assert( size_ > 0 ); front_ = ( front_ + 1 ) % capacity(); --size_; }
+		void pop_front() { xo_assert( size_ > 0 ); front_ = wrap( front_ + 1 ); --size_; }
 
-		T& back() { xo_assert( size_ > 0 ); return buffer_[ ( front_ + size_ - 1 ) % capacity() ]; }
-		const T& back() const { xo_assert( size_ > 0 ); return buffer_[ ( front_ + size_ ) % capacity() ]; }
+		T& back() { xo_assert( size_ > 0 ); return buffer_[ wrap( front_ + size_ - 1 ) ]; }
+		const T& back() const { xo_assert( size_ > 0 ); return buffer_[ wrap( front_ + size_ - 1 ) ]; }
 
 		T& front() { xo_assert( size_ > 0 ); return buffer_[ front_ ]; }
 		const T& front() const { xo_assert( size_ > 0 ); return buffer_[ front_ ]; }
@@ -43,9 +71,37 @@ namespace xo
 		bool full() const { return size() == capacity(); }
 		void clear() { front_ = size_ = 0; }
 
-		void reserve( size_t s ) { buffer_.resize( s ); }
+		/// set capacity, existing elements are kept if they fit
+		void reserve( size_t s ) { relinearize( valid_capacity( s ) ); }
 		size_t capacity() const { return buffer_.size(); }
 
+		/// contents as two contiguous segments, from front to back; the second segment is empty if the contents do not wrap
+		std::pair< segment, segment > segments() { return make_segments< segment >( buffer_.data() ); }
+		std::pair< const_segment, const_segment > segments() const { return make_segments< const_segment >( buffer_.data() ); }
+
+		/// copy values to the back using at most two block copies, grows if needed
+		void push_back( const T* values, size_t n ) {
+			if ( n == 0 ) return; // capacity may be zero, which wrap() does not support
+			if ( size_ + n > capacity() ) grow( size_ + n );
+			auto b = wrap( front_ + size_ );
+			auto n1 = std::min( n, capacity() - b );
+			std::copy( values, values + n1, buffer_.begin() + b );
+			std::copy( values + n1, values + n, buffer_.begin() );
+			size_ += n;
+		}
+
+		/// copy up to n values from the front into out and remove them, returns the number of values copied
+		size_t pop_front( T* out, size_t n ) {
+			n = std::min( n, size_ );
+			if ( n == 0 ) return 0;
+			auto n1 = std::min( n, capacity() - front_ );
+			std::copy( buffer_.begin() + front_, buffer_.begin() + front_ + n1, out );
+			std::copy( buffer_.begin(), buffer_.begin() + ( n - n1 ), out + n1 );
+			front_ = size_ == n ? 0 : wrap( front_ + n );
+			size_ -= n;
+			return n;
+		}
+
 		template< typename IT > struct iterator_impl
 		{
 			using iterator_category = std::forward_iterator_tag;
@@ -61,8 +117,8 @@ namespace xo
 			auto operator-( const iterator_impl< IT >& other ) const { return index_ - other.index_; }
 			bool operator==( const iterator_impl< IT >& other ) { return other.index_ == index_; }
 			bool operator!=( const iterator_impl< IT >& other ) { return other.index_ != index_; }
-			IT& operator*() { return const_cast<IT&>( buffer_[ index_ % buffer_.size() ] ); }
-			IT* operator->() { return const_cast<IT*>( &buffer_[ index_ % buffer_.size() ] ); }
+			IT& operator*() { return const_cast<IT&>( buffer_[ ring_index< PowerOfTwo >( index_, buffer_.size() ) ] ); }
+			IT* operator->() { return const_cast<IT*>( &buffer_[ ring_index< PowerOfTwo >( index_, buffer_.size() ) ] ); }
 
 			size_t index_;
 			const buffer_type& buffer_;
@@ -76,6 +132,27 @@ namespace xo
 		const_iterator end() const { return const_iterator( front_ + size_, buffer_ ); }
 
 	private:
+		static size_t valid_capacity( size_t s ) { return PowerOfTwo && s > 0 ? ceil_power_of_two( s ) : s; }
+		size_t wrap( size_t idx ) const { return ring_index< PowerOfTwo >( idx, capacity() ); }
+
+		template< typename S, typename P > std::pair< S, S > make_segments( P data ) const {
+			auto n1 = std::min( size_, capacity() - front_ );
+			return { S{ data + front_, n1 }, S{ data, size_ - n1 } };
+		}
+
+		// grow to at least min_capacity, doubling the capacity to keep push_back amortized O(1)
+		void grow( size_t min_capacity ) { relinearize( valid_capacity( std::max( min_capacity, 2 * capacity() ) ) ); }
+
+		// move contents to a new buffer of size new_capacity, starting at index 0
+		void relinearize( size_t new_capacity ) {
+			buffer_type new_buffer( new_capacity );
+			size_ = std::min( size_, new_capacity );
+			auto [s1, s2] = segments();
+			std::move( s2.begin(), s2.end(), std::move( s1.begin(), s1.end(), new_buffer.begin() ) );
+			buffer_ = std::move( new_buffer );
+			front_ = 0;
+		}
+
 		size_t front_;
 		size_t size_;
 		buffer_type buffer_;
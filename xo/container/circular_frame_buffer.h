@@ -1,19 +1,24 @@
 #pragma once
 
 #include "label_vector.h"
+#include "circular_deque.h"
 #include "xo/system/assert.h"
 
 namespace xo
 {
 	// #todo: deprecate? is this needed next to circular_deque?
-	template< typename T, typename L = void >
+	/// if PowerOfTwo is true, frame capacity is rounded up to a power of two and frame indices are masked instead of using modulo
+	template< typename T, typename L = void, bool PowerOfTwo = false >
 	class circular_frame_buffer
 	{
 	public:
+		using segment = ring_segment< T >;
+		using const_segment = ring_segment< const T >;
+
 		circular_frame_buffer( size_t channels = 0, size_t frames = 0 ) :
 			frame_size_( 0 ),
-			frame_capacity_( frames ),
-			data_( frames * channels ),
+			frame_capacity_( valid_capacity( frames ) ),
+			data_( frame_capacity_ * channels ),
 			labels_( channels ) {}
 		~circular_frame_buffer() {}
 
@@ -38,46 +43,65 @@ namespace xo
 		/// get the interpolated value of a specific frame / channel
 		T get_interpolated_value( index_t frame0, index_t channel, T pos ) {
 			xo_assert( ( frame0 < frame_size() ) && ( channel < this->channel_size() ) );
-			index_t ofs0 = ( frame0 % frame_capacity_ ) * this->channel_size() + channel;
-			index_t ofs1 = ( ( frame0 + 1 ) % frame_capacity_ ) * this->channel_size() + channel;
+			index_t ofs0 = wrap( frame0 ) * this->channel_size() + channel;
+			index_t ofs1 = wrap( frame0 + 1 ) * this->channel_size() + channel;
 			return ( T( 1 ) - pos ) * data_[ ofs0 ] + pos * data_[ ofs1 ];
 		}
 
 		/// access value (no bounds checking)
-		T& operator()( index_t frame, index_t channel ) { return data( frame % frame_capacity_, channel ); }
-		const T& operator()( index_t frame, index_t channel ) const { data( frame % frame_capacity_, channel ); }
+		T& operator()( index_t frame, index_t channel ) { return data( wrap( frame ), channel ); }
+		const T& operator()( index_t frame, index_t channel ) const { return data( wrap( frame ), channel ); }
 
 		/// access value of most recent frame
-		T& operator[]( index_t channel ) { return data( ( frame_size_ - 1 ) % frame_capacity_, channel ); }
-		const T& operator[]( index_t channel ) const { return data( ( frame_size_ - 1 ) % frame_capacity_, channel ); }
+		T& operator[]( index_t channel ) { return data( wrap( frame_size_ - 1 ), channel ); }
+		const T& operator[]( index_t channel ) const { return data( wrap( frame_size_ - 1 ), channel ); }
 
 		/// access value frames back
-		T& reverse( index_t frame, index_t channel ) { return data( ( frame_size_ - frame - 1 ) % frame_capacity_, channel ); }
-		const T& reverse( index_t frame, index_t channel ) const { return data( ( frame_size_ - frame - 1 ) % frame_capacity_, channel ); }
+		T& reverse( index_t frame, index_t channel ) { return data( wrap( frame_size_ - frame - 1 ), channel ); }
+		const T& reverse( index_t frame, index_t channel ) const { return data( wrap( frame_size_ - frame - 1 ), channel ); }
 
 		/// access value with bounds checking
 		T& at( index_t frame, index_t channel ) {
 			xo_assert( frame >= frame_size() - frame_capacity_ && frame < frame_size() && channel < channel_size() );
-			return data( frame % frame_capacity_, channel );
+			return data( wrap( frame ), channel );
 		}
 		const T& at( index_t frame, index_t channel ) const {
 			xo_assert( frame >= frame_size() - frame_capacity_ && frame < frame_size() && channel < channel_size() );
-			return data( frame % frame_capacity_, channel );
+			return data( wrap( frame ), channel );
 		}
 
+		/// frames in the buffer as two contiguous segments of channel_size() values per frame, from oldest to newest
+		std::pair< segment, segment > segments() { return make_segments< segment >( data_.data() ); }
+		std::pair< const_segment, const_segment > segments() const { return make_segments< const_segment >( data_.data() ); }
+
 		/// resize buffer, resets contents
 		void resize_buffer( size_t nframes, size_t nchannels, const T& value = T() ) {
-			data_.assign( nframes * nchannels, value );
-			frame_capacity_ = nframes;
+			frame_capacity_ = valid_capacity( nframes );
+			data_.assign( frame_capacity_ * nchannels, value );
 			labels_.resize( nchannels );
 		}
 
 		void resize_buffer( size_t nframes, const T& value = T() ) {
-			data_.assign( nframes * channel_size(), value );
-			frame_capacity_ = nframes;
+			frame_capacity_ = valid_capacity( nframes );
+			data_.assign( frame_capacity_ * channel_size(), value );
 		}
 
+		/// maximum number of frames in the buffer
+		size_t frame_capacity() const { return frame_capacity_; }
+
 	private:
+		static size_t valid_capacity( size_t s ) { return PowerOfTwo && s > 0 ? ceil_power_of_two( s ) : s; }
+		size_t wrap( index_t frame ) const { return ring_index< PowerOfTwo >( frame, frame_capacity_ ); }
+
+		template< typename S, typename P > std::pair< S, S > make_segments( P d ) const {
+			auto n = std::min( frame_size_, frame_capacity_ );
+			if ( n == 0 )
+				return { S{ d, 0 }, S{ d, 0 } };
+			auto first = wrap( frame_size_ - n );
+			auto n1 = std::min( n, frame_capacity_ - first );
+			return { S{ d + first * channel_size(), n1 * channel_size() }, S{ d, ( n - n1 ) * channel_size() } };
+		}
+
 		T& data( index_t frame, index_t channel ) { return data_[ frame * channel_size() + channel ]; }
 		const T& data( index_t frame, index_t channel ) const { return data_[ frame * channel_size() + channel ]; }
 
@@ -0,0 +1,225 @@
+#pragma once
+
+#include "xo/xo_types.h"
+#include "xo/system/assert.h"
+#include "xo/container/label_vector.h"
+#include "xo/container/storage.h"
+#include "xo/utility/aligned_allocator.h"
+#include "xo/numerical/math.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include <ostream>
+
+namespace xo
+{
+	/// storage class with channel-major (columnar) layout: the frames of each channel are contiguous
+	/// and each channel starts at a 64-byte boundary, which allows fast (SIMD) per-channel operations.
+	/// has the same frame / channel interface as storage, use make_column_storage / make_storage to convert.
+	template< typename T, typename L = std::string >
+	class column_storage
+	{
+	public:
+		static constexpr size_t alignment = 64;
+		using container_type = std::vector< T, aligned_allocator< T, alignment > >;
+		using value_type = T;
+		using label_type = L;
+
+		struct const_frame {
+			const_frame( const column_storage< T, L >& s, index_t f ) : sto_( s ), fidx_( f ) {}
+			const T& operator[]( index_t i ) const { return sto_( fidx_, i ); }
+			const T& operator[]( const L& l ) const { return sto_( fidx_, sto_.find_channel( l ) ); }
+			const column_storage< T, L >& sto_;
+			index_t fidx_;
+		};
+
+		struct frame {
+			frame( column_storage< T, L >& s, index_t f ) : sto_( s ), fidx_( f ) {}
+			T& operator[]( index_t i ) const { return sto_( fidx_, i ); }
+			T& operator[]( const L& l ) const { return sto_( fidx_, sto_.find_or_add_channel( l ) ); }
+			column_storage< T, L >& sto_;
+			index_t fidx_;
+		};
+
+		column_storage( size_t frames = 0, size_t channels = 0, T value = T() ) : frame_size_( 0 ), frame_capacity_( 0 ), labels_( 0 ) {
+			resize( frames, channels, value );
+		}
+
+		/// add a channel and resize buffer if needed
+		index_t add_channel( L label, const T& value = T() ) {
+			resize( frame_size(), channel_size() + 1, value );
+			return labels_.set( channel_size() - 1, label );
+		}
+
+		/// add a channel with data, resize buffer if needed
+		index_t add_channel( L label, const std::vector< T >& data ) {
+			resize( max( frame_size(), std::size( data ) ), channel_size() + 1 );
+			labels_.set( channel_size() - 1, label );
+			auto cidx = channel_size() - 1;
+			std::copy( data.begin(), data.end(), channel_data( cidx ) );
+			return cidx;
+		}
+
+		/// find index of a label
+		index_t find_channel( const L& label ) const { return labels_.find_or_throw( label ); }
+
+		/// find index of a label
+		index_t try_find_channel( const L& label ) const { return labels_.find( label ); }
+
+		/// find or add a channel
+		index_t find_or_add_channel( const L& label, const T& value = T() ) {
+			auto idx = labels_.find( label );
+			return idx == no_index ? add_channel( label, value ) : idx;
+		}
+
+		/// set channel label
+		void set_label( index_t channel, L label ) { labels_.set( channel, label ); }
+
+		/// get channel label
+		const L& get_label( index_t channel ) const { return labels_[ channel ]; }
+
+		/// add frame to storage
+		frame add_frame( T value = T( 0 ) ) { resize( frame_size() + 1, channel_size(), value ); return back(); }
+
+		/// add frame to storage
+		frame add_frame( const std::vector< T >& data ) {
+			xo_assert( std::size( data ) == channel_size() );
+			resize( frame_size() + 1, channel_size() );
+			for ( index_t ci = 0; ci < channel_size(); ++ci )
+				( *this )( frame_size() - 1, ci ) = data[ ci ];
+			return back();
+		}
+
+		/// number of channels
+		size_t channel_size() const { return labels_.size(); }
+
+		/// number of frames in storage
+		size_t frame_size() const { return frame_size_; }
+
+		/// number of frames that fit before the buffer must grow
+		size_t frame_capacity() const { return frame_capacity_; }
+
+		/// check if there is any data
+		bool empty() const { return frame_size_ == 0 || channel_size() == 0; }
+
+		/// clear the storage
+		void clear() { frame_size_ = frame_capacity_ = 0; labels_.clear(); data_.clear(); }
+
+		/// access value (no bounds checking)
+		const T& operator()( index_t frame, index_t channel ) const { return data_[ channel * frame_capacity_ + frame ]; }
+		T& operator()( index_t frame, index_t channel ) { return data_[ channel * frame_capacity_ + frame ]; }
+
+		/// contiguous, 64-byte aligned data of a channel, with frame_size() elements
+		const T* channel_data( index_t channel ) const { return data_.data() + channel * frame_capacity_; }
+		T* channel_data( index_t channel ) { return data_.data() + channel * frame_capacity_; }
+
+		/// access frame
+		const_frame operator[]( index_t f ) const { return const_frame( *this, f ); }
+		frame operator[]( index_t f ) { return frame( *this, f ); }
+		const_frame front() const { return const_frame( *this, 0 ); }
+		frame front() { return frame( *this, 0 ); }
+		const_frame back() const { return const_frame( *this, frame_size() - 1 ); }
+		frame back() { return frame( *this, frame_size() - 1 ); }
+
+		/// get the interpolated value of a specific frame / channel
+		T get_interpolated_value( T frame_idx, index_t channel ) const {
+			auto frame_f = floor( frame_idx );
+			auto frame_w = frame_idx - frame_f;
+			index_t frame0 = static_cast<index_t>( frame_f );
+			xo_assert( frame0 + 1 < frame_size() );
+			const T* d = channel_data( channel ) + frame0;
+			return ( T( 1 ) - frame_w ) * d[ 0 ] + frame_w * d[ 1 ];
+		}
+
+		/// reserve space for nframes, so that adding frames does not reallocate
+		void reserve( size_t nframes ) {
+			if ( nframes > frame_capacity_ )
+				reallocate( aligned_frame_count( nframes ), channel_size(), T() );
+		}
+
+		void resize( size_t nframes, size_t nchannels, T value = T() ) {
+			xo_error_if( nframes < frame_size() || nchannels < channel_size(), "Cannot shrink storage" );
+			if ( nframes > frame_capacity_ )
+				reallocate( aligned_frame_count( max( nframes, 2 * frame_capacity_ ) ), nchannels, value );
+			else if ( nchannels > channel_size() )
+				data_.resize( nchannels * frame_capacity_, value );
+
+			// initialize new frames of existing channels
+			for ( index_t ci = 0; ci < channel_size(); ++ci )
+				std::fill( channel_data( ci ) + frame_size_, channel_data( ci ) + nframes, value );
+
+			labels_.resize( nchannels );
+			frame_size_ = nframes;
+		}
+
+		std::vector<T> get_channel( index_t channel ) const {
+			return std::vector<T>( channel_data( channel ), channel_data( channel ) + frame_size() );
+		}
+		std::vector<T> get_channel( const L& label ) const { return get_channel( find_channel( label ) ); }
+
+		const label_vector< L >& labels() const { return labels_; }
+		const container_type& data() const { return data_; }
+
+	private:
+		/// round up number of frames so that each channel starts at an aligned address,
+		/// the channel size in bytes is a multiple of lcm( sizeof( T ), alignment )
+		static size_t aligned_frame_count( size_t n ) {
+			constexpr size_t frames_per_block = std::lcm( sizeof( T ), alignment ) / sizeof( T );
+			return ( n + frames_per_block - 1 ) / frames_per_block * frames_per_block;
+		}
+
+		void reallocate( size_t new_capacity, size_t nchannels, const T& value ) {
+			container_type new_data( nchannels * new_capacity, value );
+			for ( index_t ci = 0; ci < channel_size(); ++ci )
+				std::copy( channel_data( ci ), channel_data( ci ) + frame_size_, new_data.data() + ci * new_capacity );
+			data_ = std::move( new_data );
+			frame_capacity_ = new_capacity;
+		}
+
+		size_t frame_size_;
+		size_t frame_capacity_;
+		label_vector< L > labels_;
+		container_type data_;
+	};
+
+	/// convert storage to column_storage
+	template< typename T, typename L > column_storage< T, L > make_column_storage( const storage< T, L >& sto ) {
+		column_storage< T, L > cs;
+		cs.reserve( sto.frame_size() );
+		cs.resize( sto.frame_size(), sto.channel_size() );
+		for ( index_t ci = 0; ci < sto.channel_size(); ++ci ) {
+			cs.set_label( ci, sto.get_label( ci ) );
+			T* dst = cs.channel_data( ci );
+			for ( index_t fi = 0; fi < sto.frame_size(); ++fi )
+				dst[ fi ] = sto( fi, ci );
+		}
+		return cs;
+	}
+
+	/// convert column_storage to storage
+	template< typename T, typename L > storage< T, L > make_storage( const column_storage< T, L >& cs ) {
+		storage< T, L > sto( cs.frame_size(), cs.channel_size() );
+		for ( index_t ci = 0; ci < cs.channel_size(); ++ci ) {
+			sto.set_label( ci, cs.get_label( ci ) );
+			const T* src = cs.channel_data( ci );
+			for ( index_t fi = 0; fi < cs.frame_size(); ++fi )
+				sto( fi, ci ) = src[ fi ];
+		}
+		return sto;
+	}
+
+	template< typename T, typename L > std::ostream& operator<<( std::ostream& str, const column_storage< T, L >& buf ) {
+		for ( index_t ci = 0; ci < buf.channel_size(); ++ci ) {
+			str << buf.get_label( ci );
+			if ( ci == buf.channel_size() - 1 ) str << std::endl; else str << '\t';
+		}
+		for ( index_t fi = 0; fi < buf.frame_size(); ++fi ) {
+			for ( index_t ci = 0; ci < buf.channel_size(); ++ci ) {
+				str << buf( fi, ci );
+				if ( ci == buf.channel_size() - 1 ) str << std::endl; else str << '\t';
+			}
+		}
+		return str;
+	}
+}
@@ -66,32 +66,149 @@ namespace xo
 		else return ( v[ n / 2 ] + v[ n / 2 - 1 ] ) / std::iterator_traits< I >::value_type( 2 );
 	}
 
+	/// partially sort [b, e) so that nth contains the value it would have if the range was sorted,
+	/// with smaller values before and larger values after; uses the Floyd-Rivest algorithm,
+	/// which selects from a sample first to make the partition step close to n + min( k, n - k ) comparisons
+	template< typename I, typename P > void select_nth( I b, I nth, I e, P pred ) {
+		using D = typename std::iterator_traits< I >::difference_type;
+		D left = 0, right = e - b - 1;
+		const D k = nth - b;
+		if ( k < 0 || k > right )
+			return;
+		while ( right > left ) {
+			if ( right - left > 600 ) {
+				// recursively select from a sample, so that b[ k ] is very likely a good pivot
+				const double n = double( right - left + 1 ), i = double( k - left + 1 );
+				const double z = std::log( n ), s = 0.5 * std::exp( 2 * z / 3 );
+				const double sd = 0.5 * std::sqrt( z * s * ( n - s ) / n ) * ( i < n / 2 ? -1 : 1 );
+				const D new_left = std::max( left, D( double( k ) - i * s / n + sd ) );
+				const D new_right = std::min( right, D( double( k ) + ( n - i ) * s / n + sd ) );
+				select_nth( b + new_left, nth, b + new_right + 1, pred );
+			}
+			const auto t = b[ k ];
+			D i = left, j = right;
+			std::iter_swap( b + left, b + k );
+			if ( pred( t, b[ right ] ) )
+				std::iter_swap( b + right, b + left );
+			while ( i < j ) {
+				std::iter_swap( b + i, b + j );
+				++i, --j;
+				while ( pred( b[ i ], t ) ) ++i;
+				while ( pred( t, b[ j ] ) ) --j;
+			}
+			if ( !pred( b[ left ], t ) && !pred( t, b[ left ] ) )
+				std::iter_swap( b + left, b + j );
+			else std::iter_swap( b + ( ++j ), b + right );
+			if ( j <= k ) left = j + 1;
+			if ( k <= j ) right = j - 1;
+		}
+	}
+
+	template< typename I > void select_nth( I b, I nth, I e ) { select_nth( b, nth, e, std::less<>() ); }
+
+	/// median of [b, e), reorders the elements in the range
 	template< typename I > typename std::iterator_traits< I >::value_type median_non_const( I b, I e ) {
 		xo_error_if( e <= b, "Invalid range" );
 		auto n = e - b;
 		auto h = n / 2;
-		std::nth_element( b, b + h, e );
+		select_nth( b, b + h, e );
 		if ( n % 2 == 1 )
 			return *( b + h );
 		else return ( *( b + h ) + *std::max_element( b, b + h ) ) / 2;
 	}
 
-	template< typename C > typename C::value_type median( C v ) {
-		return median_non_const( std::begin( v ), std::end( v ) );
+	/// value at quantile q in [0, 1] of [b, e), interpolating linearly between ranks; reorders the elements in the range
+	template< typename I > typename std::iterator_traits< I >::value_type quantile_non_const( I b, I e, double q ) {
+		xo_error_if( e <= b, "Invalid range" );
+		const double pos = std::clamp( q, 0.0, 1.0 ) * double( e - b - 1 );
+		const auto lo = b + static_cast< typename std::iterator_traits< I >::difference_type >( pos );
+		select_nth( b, lo, e );
+		const double f = pos - std::floor( pos );
+		if ( f == 0.0 )
+			return *lo;
+		auto hi = *std::min_element( lo + 1, e );
+		return *lo + ( hi - *lo ) * f;
+	}
+
+	/// values at ascending quantiles [qb, qe) of [b, e), written to out; reorders the elements in the range
+	/// each selection is limited to the part of the range that is not yet partitioned
+	template< typename I, typename QI, typename O > O quantiles_non_const( I b, I e, QI qb, QI qe, O out ) {
+		xo_error_if( e <= b, "Invalid range" );
+		xo_error_if( !std::is_sorted( qb, qe ), "Quantiles must be in ascending order" );
+		using D = typename std::iterator_traits< I >::difference_type;
+		auto first = b;
+		for ( ; qb != qe; ++qb, ++out ) {
+			const double pos = std::clamp( double( *qb ), 0.0, 1.0 ) * double( e - b - 1 );
+			const auto lo = b + static_cast<D>( pos );
+			select_nth( first, lo, e );
+			const double f = pos - std::floor( pos );
+			*out = f == 0.0 ? *lo : *lo + ( *std::min_element( lo + 1, e ) - *lo ) * f;
+			first = lo;
+		}
+		return out;
+	}
+
+	/// average of the count smallest values in [b, e), reorders the elements in the range
+	template< typename I > typename std::iterator_traits< I >::value_type top_average_non_const( I b, I e, size_t count ) {
+		xo_error_if( e <= b || count == 0, "Invalid range" );
+		auto n = std::min( count, size_t( e - b ) );
+		if ( n < size_t( e - b ) )
+			select_nth( b, b + ( n - 1 ), e );
+		return average( b, b + n );
+	}
+
+	/// thread-local buffer for algorithms that reorder a copy of their input, avoids allocating for each call
+	template< typename T > std::vector< T >& scratch_buffer() {
+		thread_local std::vector< T > buffer;
+		return buffer;
+	}
+
+	template< typename C > typename C::value_type median( const C& v ) {
+		auto& buf = scratch_buffer< typename C::value_type >();
+		buf.assign( std::begin( v ), std::end( v ) );
+		return median_non_const( buf.begin(), buf.end() );
 	}
 
 	template< typename C > typename C::value_type median_non_const( C& v ) {
 		return median_non_const( std::begin( v ), std::end( v ) );
 	}
 
+	template< typename C > typename C::value_type quantile( const C& v, double q ) {
+		auto& buf = scratch_buffer< typename C::value_type >();
+		buf.assign( std::begin( v ), std::end( v ) );
+		return quantile_non_const( buf.begin(), buf.end(), q );
+	}
+
+	template< typename C, typename QC > std::vector< typename C::value_type > quantiles( const C& v, const QC& qs ) {
+		auto& buf = scratch_buffer< typename C::value_type >();
+		buf.assign( std::begin( v ), std::end( v ) );
+		std::vector< typename C::value_type > result( std::size( qs ) );
+		quantiles_non_const( buf.begin(), buf.end(), std::begin( qs ), std::end( qs ), result.begin() );
+		return result;
+	}
+
 	template< typename C > typename C::value_type median_slow( const C& v ) {
 		return median_slow( std::begin( v ), std::end( v ) );
 	}
 
+	/// average of the count smallest values in vec
 	template< typename C > typename C::value_type top_average( const C& vec, size_t count ) {
-		// #todo: use nth_element for better performance
-		C result( count );
-		std::partial_sort_copy( vec.begin(), vec.end(), result.begin(), result.end() );
-		return average( result );
+		auto& buf = scratch_buffer< typename C::value_type >();
+		auto n = size_t( std::size( vec ) );
+		if ( count > 0 && count * 8 < n ) {
+			// keep the smallest values in a max-heap, most values are rejected after one comparison
+			buf.assign( std::begin( vec ), std::begin( vec ) + count );
+			std::make_heap( buf.begin(), buf.end() );
+			for ( auto it = std::begin( vec ) + count; it != std::end( vec ); ++it ) {
+				if ( *it < buf.front() ) {
+					std::pop_heap( buf.begin(), buf.end() );
+					buf.back() = *it;
+					std::push_heap( buf.begin(), buf.end() );
+				}
+			}
+			return average( buf.begin(), buf.end() );
+		}
+		buf.assign( std::begin( vec ), std::end( vec ) );
+		return top_average_non_const( buf.begin(), buf.end(), count );
 	}
 }
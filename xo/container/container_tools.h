@@ -3,11 +3,41 @@
 #include "xo/system/assert.h"
 #include "xo/xo_types.h"
 #include "xo/string/string_type.h"
+#include <algorithm>
 #include <iterator> // #todo get rid of this header, used by std::begin / std::end
 #include <vector>
 
 namespace xo
 {
+	/// how elements with equal keys are handled when merging values into a sorted container
+	enum class duplicate_policy { keep_first, keep_last, keep_all };
+
+	/// sort elements [mid, end) of vec and merge them into the sorted range [begin, mid), then remove duplicates
+	/// equal elements keep their relative order, so keep_last keeps the element that was added last
+	template< typename V, typename Less > void sort_merge_tail( V& vec, size_t mid, Less less, duplicate_policy dp ) {
+		auto m = vec.begin() + mid;
+		std::stable_sort( m, vec.end(), less );
+		std::inplace_merge( vec.begin(), m, vec.end(), less );
+		if ( dp == duplicate_policy::keep_all || vec.empty() )
+			return;
+		size_t w = 0;
+		for ( size_t r = 1; r < vec.size(); ++r ) {
+			if ( less( vec[ w ], vec[ r ] ) ) {
+				if ( ++w != r )
+					vec[ w ] = std::move( vec[ r ] );
+			}
+			else if ( dp == duplicate_policy::keep_last )
+				vec[ w ] = std::move( vec[ r ] );
+		}
+		vec.erase( vec.begin() + w + 1, vec.end() );
+	}
+
+	/// merge the unsorted tail of vec, which starts where vec stops being sorted
+	template< typename V, typename Less > void sort_merge_unsorted_tail( V& vec, Less less, duplicate_policy dp ) {
+		auto mid = std::is_sorted_until( vec.begin(), vec.end(), less ) - vec.begin();
+		sort_merge_tail( vec, static_cast<size_t>( mid ), less, dp );
+	}
+
 	/// find element in a container
 	template< typename C > auto find( C& cont, const typename C::value_type& e )
 	{ auto it = std::begin( cont ); for ( ; it != std::end( cont ); ++it ) if ( *it == e ) break; return it; }
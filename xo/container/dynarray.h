@@ -2,26 +2,44 @@
 
 #include "container_tools.h"
 #include "xo/xo_types.h"
+#include "xo/system/system_tools.h"
 #include "xo/utility/pointer_iterator.h"
-#include "xo/utility/pointer_types.h"
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <utility>
 
 namespace xo
 {
+	/// tag to create or resize dynarray without initializing trivial types
+	struct default_init_t { explicit default_init_t() = default; };
+	inline constexpr default_init_t default_init{};
+
 	/// dynamically sized array
-	template< typename T >
+	/// storage is aligned to Alignment bytes; if HugePages is true, storage is allocated using
+	/// allocate_huge_pages(), which reduces TLB misses for very large arrays.
+	template< typename T, size_t Alignment = alignof( T ), bool HugePages = false >
 	class dynarray
 	{
+		static_assert( Alignment >= alignof( T ) && ( Alignment & ( Alignment - 1 ) ) == 0, "Alignment must be a power of two" );
+		static_assert( !HugePages || Alignment <= 4096, "Alignment cannot exceed page size" );
+
 	public:
+		using value_type = T;
 		using iterator = pointer_iterator< T >;
 		using const_iterator = pointer_iterator< const T >;
+		static constexpr size_t alignment = Alignment;
+
+		dynarray() : data_( nullptr ), size_( 0 ) {}
+		dynarray( size_t n, const T& v = T() ) : data_( allocate( n ) ), size_( n ) { std::uninitialized_fill( data_, data_ + n, v ); }
+		dynarray( size_t n, default_init_t ) : data_( allocate( n ) ), size_( n ) { std::uninitialized_default_construct( data_, data_ + n ); }
+		dynarray( const dynarray& o ) : data_( allocate( o.size_ ) ), size_( o.size_ ) { std::uninitialized_copy( o.data_, o.data_ + o.size_, data_ ); }
+		dynarray( dynarray&& o ) noexcept : data_( o.data_ ), size_( o.size_ ) { o.data_ = nullptr; o.size_ = 0; }
+		dynarray& operator=( const dynarray& o ) { if ( this != &o ) { dynarray tmp( o ); swap( tmp ); } return *this; }
+		dynarray& operator=( dynarray&& o ) noexcept { if ( this != &o ) { clear(); swap( o ); } return *this; }
+		~dynarray() { clear(); }
 
-		dynarray() : data_( nullptr ), end_( nullptr ) {}
-		dynarray( size_t n, const T& v = T() ) : data_( new T[ n ] ), end_( data_.get() + n ) { assign( v ); }
-		dynarray( const dynarray& o ) : data_( new T[ o.size() ] ), end_( data_.get() + o.size() ) { xo::copy( o.begin(), o.end(), begin() ); }
-		dynarray( dynarray&& o ) noexcept : data_( std::move( o.data_ ) ), end_( o.end_ ) {}
-		dynarray<T>& operator=( const dynarray& o ) { data_ = u_ptr< T[] >( new T[ o.size() ] ); end_ = data_.get() + o.size(); xo::copy( o.begin(), o.end(), begin() ); return *this; }
-		dynarray<T>& operator=( dynarray&& o ) noexcept { data_ = std::move( o.data_ ); end_ = o.end_; return *this; }
-		~dynarray() {}
+		void swap( dynarray& o ) noexcept { std::swap( data_, o.data_ ); std::swap( size_, o.size_ ); }
 
 		T& operator[]( size_t i ) { return data_[ i ]; }
 		const T& operator[]( size_t i ) const { return data_[ i ]; }
@@ -29,32 +47,70 @@ namespace xo
 		T& at( size_t i ) { xo_error_if( i >= size(), "dynarray index out of bounds" ); return data_[ i ]; }
 		const T& at( size_t i ) const { xo_error_if( i >= size(), "dynarray index out of bounds" ); return data_[ i ]; }
 
-		iterator begin() { return data_.get(); }
-		const_iterator begin() const { return data_.get(); }
-		const_iterator cbegin() const { return data_.get(); }
+		iterator begin() { return data_; }
+		const_iterator begin() const { return data_; }
+		const_iterator cbegin() const { return data_; }
 
-		iterator end() { return end_; }
-		const_iterator end() const { return end_; }
-		const_iterator cend() const { return end_; }
+		iterator end() { return data_ + size_; }
+		const_iterator end() const { return data_ + size_; }
+		const_iterator cend() const { return data_ + size_; }
 
-		bool empty() const { return begin() == end(); }
-		size_t size() const { return end() - begin(); }
+		bool empty() const { return size_ == 0; }
+		size_t size() const { return size_; }
 
-		void assign( const T& v ) { std::fill( begin(), end(), v ); }
+		void assign( const T& v ) { std::fill( data_, data_ + size_, v ); }
 
-		void resize( size_t n, const T& v = T() ) { data_.reset( new T[ n ] ); end_ = data_.get() + n; assign( v ); }
-		void clear() { data_.reset(); end_ = data_.get(); }
+		/// resize array, existing elements are kept and new elements are set to v
+		void resize( size_t n, const T& v = T() ) { resize_impl( n, [&]( T* b, T* e ) { std::uninitialized_fill( b, e, v ); } ); }
+
+		/// resize array, existing elements are kept and new elements are default-initialized
+		void resize( size_t n, default_init_t ) { resize_impl( n, []( T* b, T* e ) { std::uninitialized_default_construct( b, e ); } ); }
+
+		void clear() {
+			std::destroy( data_, data_ + size_ );
+			deallocate( data_, size_ );
+			data_ = nullptr;
+			size_ = 0;
+		}
 
-		T* data() { return data_.get(); }
-		const T* data() const { return data_.get(); }
+		T* data() { return data_; }
+		const T* data() const { return data_; }
 
 	private:
-		u_ptr< T[] > data_;
-		T* end_;
+		static T* allocate( size_t n ) {
+			if ( n == 0 )
+				return nullptr;
+			if constexpr ( HugePages )
+				return static_cast<T*>( allocate_huge_pages( n * sizeof( T ) ) );
+			else return static_cast<T*>( ::operator new( n * sizeof( T ), std::align_val_t( Alignment ) ) );
+		}
+
+		static void deallocate( T* p, size_t n ) {
+			if ( !p )
+				return;
+			if constexpr ( HugePages )
+				free_huge_pages( p, n * sizeof( T ) );
+			else ::operator delete( p, std::align_val_t( Alignment ) );
+		}
+
+		template< typename F > void resize_impl( size_t n, F init_fn ) {
+			if ( n == size_ )
+				return;
+			auto* new_data = allocate( n );
+			auto keep = std::min( n, size_ );
+			init_fn( new_data + keep, new_data + n ); // before moving, the init value may refer to an element
+			std::uninitialized_move( data_, data_ + keep, new_data );
+			clear();
+			data_ = new_data;
+			size_ = n;
+		}
+
+		T* data_;
+		size_t size_;
 	};
 
-	template< typename T >
-	bool operator==( const dynarray< T >& v1, const dynarray< T >& v2 ) {
+	template< typename T, size_t A, bool H >
+	bool operator==( const dynarray< T, A, H >& v1, const dynarray< T, A, H >& v2 ) {
 		if ( v1.size() == v2.size() ) {
 			for ( index_t i = 0; i < v1.size(); ++i )
 				if ( v1[ i ] != v2[ i ] )
@@ -64,7 +120,7 @@ namespace xo
 		else return false;
 	}
 
-	template< typename T >
-	bool operator!=( const dynarray< T >& v1, const dynarray< T >& v2 )
+	template< typename T, size_t A, bool H >
+	bool operator!=( const dynarray< T, A, H >& v1, const dynarray< T, A, H >& v2 )
 	{ return !( v1 == v2 ); }
 }
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "xo/xo_types.h"
+#include "xo/system/assert.h"
+#include "xo/container/container_tools.h"
+#include "xo/container/pair_type.h"
+#include "xo/container/vector_type.h"
+#include "xo/string/string_cast.h"
+#include "xo/utility/aligned_allocator.h"
+#include <initializer_list>
+
+#if defined( __GNUC__ ) || defined( __clang__ )
+#	define XO_PREFETCH( ADDRESS_ ) __builtin_prefetch( ADDRESS_ )
+#else
+#	define XO_PREFETCH( ADDRESS_ )
+#endif
+
+namespace xo
+{
+	/// read-optimized sorted map with the same lookup interface as flat_map
+	/// keys are stored separately from the values, in Eytzinger (breadth-first) order, which allows a
+	/// branchless search that prefetches the cache lines of the next levels. Values are stored in
+	/// key order, so iteration is the same as for flat_map. Keys cannot be added after construction.
+	template< typename K, typename V >
+	class eytzinger_map
+	{
+	public:
+		using key_type = K;
+		using mapped_type = V;
+		using value_type = typename xo::pair< K, V >;
+		using container_t = typename xo::vector< value_type >;
+		using iterator = typename container_t::iterator;
+		using const_iterator = typename container_t::const_iterator;
+
+		eytzinger_map() : keys_( 1 ), ranks_( 1 ) {}
+		eytzinger_map( std::initializer_list< value_type > l ) : data_( l ) { build( duplicate_policy::keep_last ); }
+		template< typename It > eytzinger_map( It first, It last, duplicate_policy dp = duplicate_policy::keep_last ) : data_( first, last ) { build( dp ); }
+
+		/// create from a sorted container with unique keys, such as flat_map
+		template< typename M > static eytzinger_map from_sorted( const M& m ) {
+			eytzinger_map em;
+			em.data_.assign( m.begin(), m.end() );
+			em.build_keys();
+			return em;
+		}
+
+		bool empty() const { return data_.empty(); }
+		size_t size() const { return data_.size(); }
+
+		iterator begin() { return data_.begin(); }
+		const_iterator begin() const { return data_.begin(); }
+		const_iterator cbegin() const { return data_.cbegin(); }
+		iterator end() { return data_.end(); }
+		const_iterator end() const { return data_.end(); }
+		const_iterator cend() const { return data_.cend(); }
+
+		const value_type& front() const { return data_.front(); }
+		const value_type& back() const { return data_.back(); }
+
+		/// first element with a key not less than key
+		iterator lower_bound( const key_type& key ) { return begin() + search( [&]( const K& k ) { return k < key; } ); }
+		const_iterator lower_bound( const key_type& key ) const { return begin() + search( [&]( const K& k ) { return k < key; } ); }
+
+		/// first element with a key greater than key
+		iterator upper_bound( const key_type& key ) { return begin() + search( [&]( const K& k ) { return !( key < k ); } ); }
+		const_iterator upper_bound( const key_type& key ) const { return begin() + search( [&]( const K& k ) { return !( key < k ); } ); }
+
+		iterator find( const key_type& key ) {
+			auto it = lower_bound( key );
+			return ( it != end() && it->first == key ) ? it : end();
+		}
+		const_iterator find( const key_type& key ) const {
+			auto it = lower_bound( key );
+			return ( it != end() && it->first == key ) ? it : end();
+		}
+
+		size_t count( const key_type& key ) const { return contains( key ) ? 1 : 0; }
+		bool contains( const key_type& key ) const { return find( key ) != end(); }
+
+		V& at( const key_type& key ) {
+			auto it = find( key );
+			xo_error_if( it == end(), "Could not find key: " + to_str( key ) );
+			return it->second;
+		}
+		const V& at( const key_type& key ) const {
+			auto it = find( key );
+			xo_error_if( it == end(), "Could not find key: " + to_str( key ) );
+			return it->second;
+		}
+		const V& operator[]( const key_type& key ) const { return at( key ); }
+
+	private:
+		// number of keys in a cache line, the search prefetches the line with the descendants this many levels down
+		static constexpr size_t keys_per_line = sizeof( K ) < 64 ? 64 / sizeof( K ) : 1;
+
+		// branchless search for the first key for which go_right returns false, returns its index in data_
+		template< typename P > size_t search( P go_right ) const {
+			const auto n = data_.size();
+			size_t k = 1;
+			while ( k <= n ) {
+				XO_PREFETCH( keys_.data() + k * keys_per_line );
+				k = 2 * k + size_t( go_right( keys_[ k ] ) );
+			}
+			// the answer is the last node where the search went left, remove all right turns and one left turn
+			k >>= trailing_ones( k ) + 1;
+			return k == 0 ? n : ranks_[ k ];
+		}
+
+		static size_t trailing_ones( size_t k ) {
+#if defined( __GNUC__ ) || defined( __clang__ )
+			return static_cast<size_t>( __builtin_ctzll( ~static_cast<unsigned long long>( k ) ) );
+#else
+			size_t n = 0;
+			for ( ; k & 1; k >>= 1 ) ++n;
+			return n;
+#endif
+		}
+
+		void build( duplicate_policy dp ) {
+			sort_merge_unsorted_tail( data_, []( const value_type& a, const value_type& b ) { return a.first < b.first; }, dp );
+			build_keys();
+		}
+
+		// keys_ and ranks_ are 1-based, keys_[ k ] has children keys_[ 2k ] and keys_[ 2k + 1 ]
+		void build_keys() {
+			keys_.assign( data_.size() + 1, K() );
+			ranks_.assign( data_.size() + 1, 0 );
+			size_t rank = 0;
+			build_node( 1, rank );
+		}
+		void build_node( size_t k, size_t& rank ) {
+			if ( k <= data_.size() ) {
+				build_node( 2 * k, rank );
+				keys_[ k ] = data_[ rank ].first;
+				ranks_[ k ] = rank++;
+				build_node( 2 * k + 1, rank );
+			}
+		}
+
+		container_t data_;
+		std::vector< K, aligned_allocator< K > > keys_;
+		std::vector< size_t > ranks_;
+	};
+}
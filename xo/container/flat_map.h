@@ -3,6 +3,7 @@
 #include <algorithm>
 #include "xo/container/vector_type.h"
 #include "xo/container/pair_type.h"
+#include "xo/container/container_tools.h"
 #include "xo/system/assert.h"
 #include "xo/string/string_cast.h"
 #include "xo/container/prop_node.h"
@@ -26,7 +27,8 @@ namespace xo
 		~flat_map() = default;
 		flat_map( const flat_map& ) = default;
 		flat_map( flat_map&& other ) = default;
-		flat_map( std::initializer_list< value_type > l ) : data_( l ) { sort(); }
+		flat_map( std::initializer_list< value_type > l ) : data_( l ) { merge_unsorted( duplicate_policy::keep_last ); }
+		template< typename It > flat_map( It first, It last, duplicate_policy dp = duplicate_policy::keep_last ) : data_( first, last ) { merge_unsorted( dp ); }
 		flat_map& operator=( const flat_map& other ) = default;
 		flat_map& operator=( flat_map&& other ) = default;
 
@@ -105,6 +107,20 @@ namespace xo
 			else return make_pair( data_.insert( it, std::move( value ) ), true );
 		}
 
+		/// insert range of unsorted values, which are sorted and merged in a single pass
+		template< typename It > void insert( It first, It last, duplicate_policy dp = duplicate_policy::keep_last ) {
+			auto mid = data_.size();
+			data_.insert( data_.end(), first, last );
+			sort_merge_tail( data_, mid, key_less(), dp );
+		}
+
+		/// append value without sorting, commit_deferred() must be called before accessing the map
+		void insert_deferred( const value_type& value ) { data_.push_back( value ); }
+		void insert_deferred( value_type&& value ) { data_.push_back( std::move( value ) ); }
+
+		/// sort and merge all values added with insert_deferred()
+		void commit_deferred( duplicate_policy dp = duplicate_policy::keep_last ) { merge_unsorted( dp ); }
+
 		V& operator[]( const key_type& key ) {
 			auto it = lower_bound( key );
 			if ( it != end() && it->first == key )
@@ -130,9 +146,8 @@ namespace xo
 
 	private:
 		container_t data_;
-		void sort() {
-			std::sort( data_.begin(), data_.end(), [&]( const value_type& a, const value_type& b ) { return a.first < b.first; } );
-		}
+		static auto key_less() { return []( const value_type& a, const value_type& b ) { return a.first < b.first; }; }
+		void merge_unsorted( duplicate_policy dp ) { sort_merge_unsorted_tail( data_, key_less(), dp ); }
 	};
 
 	/// convert flat_map to string
@@ -147,10 +162,14 @@ namespace xo
 
 	template< typename K, typename V >
 	bool from_prop_node( const prop_node& pn, flat_map<K, V>& m ) {
-		m.reserve( pn.size() );
+		m.reserve( m.size() + pn.size() );
 		bool success = true;
-		for ( const auto& [key, value] : pn )
-			success &= from_prop_node( value, m[ key ] );
+		for ( const auto& [key, value] : pn ) {
+			V v{};
+			success &= from_prop_node( value, v );
+			m.insert_deferred( typename flat_map<K, V>::value_type( key, std::move( v ) ) );
+		}
+		m.commit_deferred();
 		pn.access();
 		return success;
 	};
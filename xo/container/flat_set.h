@@ -1,8 +1,10 @@
 #pragma once
 
 #include <algorithm>
+#include <functional>
 #include "xo/container/vector_type.h"
 #include "xo/container/pair_type.h"
+#include "xo/container/container_tools.h"
 #include "xo/system/assert.h"
 #include "xo/string/string_cast.h"
 
@@ -23,7 +25,8 @@ namespace xo
 		~flat_set() = default;
 		flat_set( const flat_set& other ) = default;
 		flat_set( flat_set&& other ) = default;
-		flat_set( std::initializer_list< key_type > l ) : data_( l ) { sort(); }
+		flat_set( std::initializer_list< key_type > l ) : data_( l ) { merge_unsorted( duplicate_policy::keep_first ); }
+		template< typename It > flat_set( It first, It last ) : data_( first, last ) { merge_unsorted( duplicate_policy::keep_first ); }
 		flat_set& operator=( const flat_set& other ) = default;
 		flat_set& operator=( flat_set&& other ) = default;
 
@@ -98,13 +101,25 @@ namespace xo
 			else return make_pair( data_.insert( it, std::move( value ) ), true );
 		}
 
+		/// insert range of unsorted values, which are sorted and merged in a single pass
+		template< typename It > void insert( It first, It last ) {
+			auto mid = data_.size();
+			data_.insert( data_.end(), first, last );
+			sort_merge_tail( data_, mid, std::less< key_type >(), duplicate_policy::keep_first );
+		}
+
+		/// append value without sorting, commit_deferred() must be called before accessing the set
+		void insert_deferred( const key_type& value ) { data_.push_back( value ); }
+		void insert_deferred( key_type&& value ) { data_.push_back( std::move( value ) ); }
+
+		/// sort and merge all values added with insert_deferred()
+		void commit_deferred() { merge_unsorted( duplicate_policy::keep_first ); }
+
 		void reserve( size_t s ) { data_.reserve( s ); }
 
 	private:
 		container_t data_;
-		void sort() {
-			std::sort( data_.begin(), data_.end(), [&]( const key_type& a, const key_type& b ) { return a < b; } );
-		}
+		void merge_unsorted( duplicate_policy dp ) { sort_merge_unsorted_tail( data_, std::less< key_type >(), dp ); }
 	};
 
 	/// convert flat_set to string
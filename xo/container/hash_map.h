@@ -0,0 +1,243 @@
+#pragma once
+
+#include "xo/xo_types.h"
+#include "xo/system/assert.h"
+#include "xo/numerical/math.h"
+#include "xo/utility/hash.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace xo
+{
+	/// open-addressing hash map using Robin Hood linear probing
+	/// probe distances are stored in a separate byte array, so most probes do not touch the values.
+	/// lookups accept any key type supported by H and E, e.g. std::string_view for string keys.
+	/// insertion and erasure invalidate iterators and references.
+	template< typename K, typename V, typename H = hash_fn, typename E = std::equal_to<> >
+	class hash_map
+	{
+	public:
+		using key_type = K;
+		using mapped_type = V;
+		using value_type = std::pair< K, V >;
+
+		template< typename M, typename VT > struct iterator_impl
+		{
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = VT;
+			using difference_type = std::ptrdiff_t;
+			using pointer = VT*;
+			using reference = VT&;
+			iterator_impl( M* m, size_t idx ) : map_( m ), idx_( idx ) { skip_empty(); }
+			template< typename M2, typename VT2 > iterator_impl( const iterator_impl< M2, VT2 >& o ) : map_( o.map_ ), idx_( o.idx_ ) {}
+			iterator_impl& operator++() { ++idx_; skip_empty(); return *this; }
+			iterator_impl operator++( int ) { auto ret = *this; ++*this; return ret; }
+			VT& operator*() const { return map_->slots_[ idx_ ]; }
+			VT* operator->() const { return &map_->slots_[ idx_ ]; }
+			bool operator==( const iterator_impl& o ) const { return idx_ == o.idx_; }
+			bool operator!=( const iterator_impl& o ) const { return idx_ != o.idx_; }
+			void skip_empty() { while ( idx_ < map_->capacity() && map_->dist_[ idx_ ] == 0 ) ++idx_; }
+			M* map_;
+			size_t idx_;
+		};
+		using iterator = iterator_impl< hash_map, value_type >;
+		using const_iterator = iterator_impl< const hash_map, const value_type >;
+
+		hash_map() : mask_( 0 ), size_( 0 ) {}
+		hash_map( std::initializer_list< value_type > l ) : hash_map() { reserve( l.size() ); for ( auto& e : l ) insert( e ); }
+		hash_map( const hash_map& other ) : hash_map() { reserve( other.size() ); for ( auto& e : other ) insert( e ); }
+		hash_map( hash_map&& other ) noexcept : hash_map() { swap( other ); }
+		~hash_map() { clear(); }
+		hash_map& operator=( const hash_map& other ) { if ( this != &other ) { hash_map tmp( other ); swap( tmp ); } return *this; }
+		hash_map& operator=( hash_map&& other ) noexcept { if ( this != &other ) { clear(); swap( other ); } return *this; }
+
+		void swap( hash_map& other ) noexcept {
+			std::swap( dist_, other.dist_ );
+			std::swap( slots_, other.slots_ );
+			std::swap( mask_, other.mask_ );
+			std::swap( size_, other.size_ );
+		}
+
+		size_t size() const { return size_; }
+		bool empty() const { return size_ == 0; }
+		size_t capacity() const { return slots_ ? mask_ + 1 : 0; }
+
+		iterator begin() { return iterator( this, 0 ); }
+		iterator end() { return iterator( this, capacity() ); }
+		const_iterator begin() const { return const_iterator( this, 0 ); }
+		const_iterator end() const { return const_iterator( this, capacity() ); }
+
+		/// make sure n elements can be stored without rehashing
+		void reserve( size_t n ) {
+			if ( n * 8 > capacity() * max_load_eighths )
+				xo_error_if( !rehash( ceil_power_of_two( std::max< size_t >( 8, ( n * 8 + max_load_eighths - 1 ) / max_load_eighths ) ) ), "hash_map probe distance overflow" );
+		}
+
+		void clear() {
+			if constexpr ( !std::is_trivially_destructible_v< value_type > )
+				for ( size_t i = 0; i < capacity(); ++i )
+					if ( dist_[ i ] ) slots_[ i ].~value_type();
+			if ( slots_ )
+				std::fill( dist_.get(), dist_.get() + capacity(), uint8_t( 0 ) );
+			size_ = 0;
+		}
+
+		template< typename Q > iterator find( const Q& key ) { return iterator( this, find_index( key ) ); }
+		template< typename Q > const_iterator find( const Q& key ) const { return const_iterator( this, find_index( key ) ); }
+		template< typename Q > bool contains( const Q& key ) const { return find_index( key ) != capacity(); }
+		template< typename Q > size_t count( const Q& key ) const { return contains( key ) ? 1 : 0; }
+
+		/// insert value if key does not exist, returns iterator and true if inserted
+		template< typename KK, typename... Args > std::pair< iterator, bool > try_emplace( KK&& key, Args&&... args ) {
+			const auto h = hasher_( key );
+			if ( auto idx = find_index( key, h ); idx != capacity() )
+				return { iterator( this, idx ), false };
+			reserve( size_ + 1 );
+			for ( int attempt = 0; ; ++attempt ) {
+				auto [idx, dist] = insert_position( dist_.get(), mask_, h );
+				if ( idx != no_index && make_room( idx, dist ) ) {
+					new( slots_.get() + idx ) value_type( std::piecewise_construct,
+						std::forward_as_tuple( std::forward< KK >( key ) ), std::forward_as_tuple( std::forward< Args >( args )... ) );
+					++size_;
+					return { iterator( this, idx ), true };
+				}
+				// probe distance too large; growing only helps if the hashes differ, so the number of attempts is limited
+				xo_error_if( attempt >= max_rehash_attempts || !rehash( 2 * capacity() ), "hash_map probe distance overflow, too many keys have the same hash" );
+			}
+		}
+
+		std::pair< iterator, bool > insert( const value_type& value ) { return try_emplace( value.first, value.second ); }
+		std::pair< iterator, bool > insert( value_type&& value ) { return try_emplace( std::move( value.first ), std::move( value.second ) ); }
+
+		V& operator[]( const K& key ) { return try_emplace( key ).first->second; }
+		V& operator[]( K&& key ) { return try_emplace( std::move( key ) ).first->second; }
+
+		template< typename Q > V& at( const Q& key ) {
+			auto idx = find_index( key );
+			xo_error_if( idx == capacity(), "Could not find key in hash_map" );
+			return slots_[ idx ].second;
+		}
+		template< typename Q > const V& at( const Q& key ) const {
+			auto idx = find_index( key );
+			xo_error_if( idx == capacity(), "Could not find key in hash_map" );
+			return slots_[ idx ].second;
+		}
+
+		/// erase element with key, returns number of elements erased
+		template< typename Q > size_t erase( const Q& key ) {
+			auto idx = find_index( key );
+			if ( idx == capacity() )
+				return 0;
+			slots_[ idx ].~value_type();
+			// backward shift: move subsequent displaced elements one slot closer to their home
+			for ( auto next = ( idx + 1 ) & mask_; dist_[ next ] > 1; idx = next, next = ( next + 1 ) & mask_ ) {
+				new( slots_.get() + idx ) value_type( std::move( slots_[ next ] ) );
+				slots_[ next ].~value_type();
+				dist_[ idx ] = dist_[ next ] - 1;
+			}
+			dist_[ idx ] = 0;
+			--size_;
+			return 1;
+		}
+
+	private:
+		// maximum load factor, in eighths
+		static constexpr size_t max_load_eighths = 7;
+
+		// probe distance + 1 is stored per slot, 0 means empty
+		static constexpr uint8_t max_dist = 255;
+
+		// number of times the table is grown when an insertion exceeds max_dist
+		static constexpr int max_rehash_attempts = 4;
+
+		struct slot_deleter { void operator()( value_type* p ) const { ::operator delete( static_cast<void*>( p ) ); } };
+
+		template< typename Q > size_t find_index( const Q& key ) const { return find_index( key, hasher_( key ) ); }
+		template< typename Q > size_t find_index( const Q& key, hash_t h ) const {
+			if ( size_ == 0 )
+				return capacity();
+			auto idx = static_cast<size_t>( h ) & mask_;
+			for ( uint8_t dist = 1; dist_[ idx ] >= dist; ++dist, idx = ( idx + 1 ) & mask_ )
+				if ( dist_[ idx ] == dist && equal_( slots_[ idx ].first, key ) )
+					return idx;
+			return capacity();
+		}
+
+		// find the first slot where an element with hash h can be placed, in Robin Hood order
+		static std::pair< size_t, uint8_t > insert_position( const uint8_t* dists, size_t mask, hash_t h ) {
+			auto idx = static_cast<size_t>( h ) & mask;
+			for ( uint8_t dist = 1; dist < max_dist; ++dist, idx = ( idx + 1 ) & mask )
+				if ( dists[ idx ] < dist )
+					return { idx, dist };
+			return { no_index, 0 };
+		}
+
+		// shift the elements starting at idx one slot forward using move_fn( to, from ), and mark idx as occupied with distance dist
+		// returns false without changing anything if a shifted element would exceed max_dist
+		template< typename M > static bool make_room( uint8_t* dists, size_t mask, size_t idx, uint8_t dist, M move_fn ) {
+			auto empty = idx;
+			while ( dists[ empty ] != 0 ) {
+				if ( dists[ empty ] + 1 >= max_dist )
+					return false;
+				empty = ( empty + 1 ) & mask;
+			}
+			for ( auto i = empty; i != idx; ) {
+				auto prev = ( i + mask ) & mask;
+				move_fn( i, prev );
+				dists[ i ] = dists[ prev ] + 1;
+				i = prev;
+			}
+			dists[ idx ] = dist;
+			return true;
+		}
+
+		bool make_room( size_t idx, uint8_t dist ) {
+			return make_room( dist_.get(), mask_, idx, dist, [this]( size_t to, size_t from ) {
+				new( slots_.get() + to ) value_type( std::move( slots_[ from ] ) );
+				slots_[ from ].~value_type();
+			} );
+		}
+
+		// move all elements to a table with new_capacity slots; the new layout is computed first,
+		// so that the map is left unchanged if the elements do not fit
+		bool rehash( size_t new_capacity ) {
+			const auto new_mask = new_capacity - 1;
+			std::unique_ptr< uint8_t[] > new_dist( new uint8_t[ new_capacity ]() );
+			std::vector< size_t > origin( new_capacity );
+			for ( size_t i = 0; i < capacity(); ++i ) {
+				if ( dist_[ i ] ) {
+					auto [idx, dist] = insert_position( new_dist.get(), new_mask, hasher_( slots_[ i ].first ) );
+					if ( idx == no_index || !make_room( new_dist.get(), new_mask, idx, dist, [&]( size_t to, size_t from ) { origin[ to ] = origin[ from ]; } ) )
+						return false;
+					origin[ idx ] = i;
+				}
+			}
+
+			std::unique_ptr< value_type[], slot_deleter > new_slots( static_cast<value_type*>( ::operator new( new_capacity * sizeof( value_type ) ) ) );
+			for ( size_t j = 0; j < new_capacity; ++j ) {
+				if ( new_dist[ j ] ) {
+					auto& v = slots_[ origin[ j ] ];
+					new( new_slots.get() + j ) value_type( std::move( v ) );
+					v.~value_type();
+				}
+			}
+			dist_ = std::move( new_dist );
+			slots_ = std::move( new_slots );
+			mask_ = new_mask;
+			return true;
+		}
+
+		std::unique_ptr< uint8_t[] > dist_;
+		std::unique_ptr< value_type[], slot_deleter > slots_;
+		size_t mask_;
+		size_t size_;
+		H hasher_;
+		E equal_;
+	};
+}
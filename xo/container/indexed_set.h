@@ -1,7 +1,7 @@
 #pragma once
 
 #include "xo/xo_types.h"
-#include "xo/container/flat_map.h"
+#include "xo/container/hash_map.h"
 #include "xo/numerical/constants.h"
 #include "xo/utility/optional.h"
 #include <vector>
@@ -30,7 +30,7 @@ namespace xo
 				auto index = values_.size() - 1;
 				// check if the index is valid (must be SMALLER than max to avoid sentinel)
 				xo_error_if( index >= size_t( constants<I>::max() ), "index_set overflow" );
-				return indices_[ value ] = static_cast<I>( index );
+				return indices_.try_emplace( value, static_cast<I>( index ) ).first->second;
 			}
 			else return it->second; // get existing
 		}
@@ -41,6 +41,6 @@ namespace xo
 
 	private:
 		std::vector< T > values_;
-		flat_map< T, I > indices_;
+		hash_map< T, I > indices_;
 	};
 }
@@ -1,9 +1,9 @@
 #pragma once
 
 #include "xo/xo_types.h"
-#include <unordered_map>
 #include <vector>
 #include "xo/system/assert.h"
+#include "xo/container/hash_map.h"
 
 namespace xo
 {
@@ -32,15 +32,24 @@ namespace xo
 			return it->second;
 		}
 
-		index_t find_or_add( const L& label ) const {
-			auto it = label_indices_.find( label );
-			if ( it == label_indices_.end() ) {
+		index_t find_or_add( const L& label ) {
+			auto [it, is_new] = label_indices_.try_emplace( label, labels_.size() );
+			if ( is_new )
 				labels_.push_back( label );
-				return label_indices_[ label ] = labels_.size() - 1;
-			}
-			else return it->second;
+			return it->second;
 		}
 
+		/// find or add multiple labels, the resulting indices can be cached for indexed access
+		std::vector< index_t > find_or_add( const std::vector< L >& labels ) {
+			std::vector< index_t > indices;
+			indices.reserve( labels.size() );
+			for ( const auto& l : labels )
+				indices.push_back( find_or_add( l ) );
+			return indices;
+		}
+
+		void reserve( size_t s ) { labels_.reserve( s ); label_indices_.reserve( s ); }
+
 		void resize( size_t s ) { xo_assert( s >= size() ); labels_.resize( s ); }
 
 		void clear() { labels_.clear(); label_indices_.clear(); }
@@ -61,7 +70,7 @@ namespace xo
 
 	private:
 		std::vector< L > labels_;
-		std::unordered_map< L, index_t > label_indices_;
+		hash_map< L, index_t > label_indices_;
 	};
 
 	template<> struct label_vector< void >
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "xo/xo_types.h"
+#include "xo/system/assert.h"
+#include "xo/utility/handle.h"
+#include "xo/container/vector_type.h"
+
+namespace xo
+{
+	/// container with O(1) insert and erase that is accessed through stable handles
+	/// handles contain a slot index and a generation counter, so handles to erased elements are detected.
+	/// elements are stored contiguously for fast iteration; erase moves the last element into the gap.
+	template< typename T, typename I = uint64 >
+	class slot_map
+	{
+	public:
+		using value_type = T;
+		using handle_type = handle< T, I >;
+		using iterator = typename vector< T >::iterator;
+		using const_iterator = typename vector< T >::const_iterator;
+
+		static constexpr int index_bits = int( sizeof( I ) * 4 );
+		static constexpr I index_mask = ( I( 1 ) << index_bits ) - 1;
+
+		slot_map() : free_head_( no_slot ) {}
+
+		template< typename... Args > handle_type emplace( Args&&... args ) {
+			xo_error_if( free_head_ == no_slot && slots_.size() >= size_t( index_mask ), "slot_map overflow" );
+			data_.emplace_back( std::forward< Args >( args )... );
+			I slot_idx;
+			if ( free_head_ != no_slot ) {
+				slot_idx = free_head_;
+				free_head_ = slots_[ slot_idx ].index;
+			}
+			else {
+				slot_idx = static_cast<I>( slots_.size() );
+				slots_.push_back( slot{ 0, 0 } );
+			}
+			slots_[ slot_idx ].index = static_cast<I>( data_.size() - 1 );
+			data_slots_.push_back( slot_idx );
+			return make_handle( slot_idx );
+		}
+		handle_type insert( const T& e ) { return emplace( e ); }
+		handle_type insert( T&& e ) { return emplace( std::move( e ) ); }
+
+		/// erase element, returns false if the handle is no longer valid
+		bool erase( handle_type h ) {
+			if ( !contains( h ) )
+				return false;
+			auto slot_idx = slot_index( h );
+			auto& s = slots_[ slot_idx ];
+			auto dense_idx = s.index;
+			if ( dense_idx != data_.size() - 1 ) {
+				// move last element into the gap
+				data_[ dense_idx ] = std::move( data_.back() );
+				data_slots_[ dense_idx ] = data_slots_.back();
+				slots_[ data_slots_[ dense_idx ] ].index = dense_idx;
+			}
+			data_.pop_back();
+			data_slots_.pop_back();
+			release_slot( slot_idx );
+			return true;
+		}
+
+		/// check if the handle refers to an element in the container
+		bool contains( handle_type h ) const {
+			auto slot_idx = slot_index( h );
+			return h && slot_idx < slots_.size() && slots_[ slot_idx ].generation == generation( h );
+		}
+
+		/// get pointer to element, or nullptr if the handle is no longer valid
+		T* try_get( handle_type h ) { return contains( h ) ? &data_[ slots_[ slot_index( h ) ].index ] : nullptr; }
+		const T* try_get( handle_type h ) const { return contains( h ) ? &data_[ slots_[ slot_index( h ) ].index ] : nullptr; }
+
+		T& operator[]( handle_type h ) { xo_assert( contains( h ) ); return data_[ slots_[ slot_index( h ) ].index ]; }
+		const T& operator[]( handle_type h ) const { xo_assert( contains( h ) ); return data_[ slots_[ slot_index( h ) ].index ]; }
+
+		T& at( handle_type h ) { xo_error_if( !contains( h ), "Invalid slot_map handle" ); return ( *this )[ h ]; }
+		const T& at( handle_type h ) const { xo_error_if( !contains( h ), "Invalid slot_map handle" ); return ( *this )[ h ]; }
+
+		/// handle of the element at position idx in the contiguous storage
+		handle_type handle_at( index_t idx ) const { return make_handle( data_slots_[ idx ] ); }
+
+		void clear() {
+			for ( auto slot_idx : data_slots_ )
+				release_slot( slot_idx );
+			data_.clear();
+			data_slots_.clear();
+		}
+		void reserve( size_t n ) { data_.reserve( n ); data_slots_.reserve( n ); slots_.reserve( n ); }
+
+		size_t size() const { return data_.size(); }
+		bool empty() const { return data_.empty(); }
+
+		iterator begin() { return data_.begin(); }
+		iterator end() { return data_.end(); }
+		const_iterator begin() const { return data_.begin(); }
+		const_iterator end() const { return data_.end(); }
+		T* data() { return data_.data(); }
+		const T* data() const { return data_.data(); }
+
+	private:
+		// index contains the position in data_ for used slots, or the next free slot for unused slots
+		struct slot { I index; I generation; };
+		static constexpr I no_slot = ~I( 0 );
+
+		static I slot_index( handle_type h ) { return h.value() & index_mask; }
+		static I generation( handle_type h ) { return h.value() >> index_bits; }
+		handle_type make_handle( I slot_idx ) const { return handle_type( ( slots_[ slot_idx ].generation << index_bits ) | slot_idx ); }
+
+		void release_slot( I slot_idx ) {
+			auto& s = slots_[ slot_idx ];
+			s.generation = ( s.generation + 1 ) & index_mask; // slot indices never reach index_mask, so no handle is all-ones
+			s.index = free_head_;
+			free_head_ = slot_idx;
+		}
+
+		vector< T > data_;
+		vector< I > data_slots_;
+		vector< slot > slots_;
+		I free_head_;
+	};
+}
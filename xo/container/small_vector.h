@@ -1,54 +1,216 @@
 #pragma once
+
+#include "xo/xo_types.h"
+#include "xo/system/assert.h"
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
 #include <type_traits>
+#include <utility>
 
 namespace xo
 {
+	/// vector that stores up to N elements inline and moves to the heap when it grows beyond that
+	/// trivially copyable types are copied and moved using memcpy / memmove
 	template< typename T, size_t N >
 	class small_vector
 	{
 	public:
-		typedef T* iterator;
-		typedef const T* const_iterator;
+		using value_type = T;
+		using size_type = size_t;
+		using reference = T&;
+		using const_reference = const T&;
+		using iterator = T*;
+		using const_iterator = const T*;
+
+		small_vector() : data_( inline_data() ), size_( 0 ), capacity_( N ) {}
+		explicit small_vector( size_t n ) : small_vector() { resize( n ); }
+		small_vector( size_t n, const T& v ) : small_vector() { resize( n, v ); }
+		small_vector( std::initializer_list< T > il ) : small_vector() { assign( il.begin(), il.end() ); }
+		template< typename It, typename = typename std::iterator_traits< It >::iterator_category >
+		small_vector( It first, It last ) : small_vector() { assign( first, last ); }
+		small_vector( const small_vector& other ) : small_vector() { assign( other.begin(), other.end() ); }
+		small_vector( small_vector&& other ) noexcept( std::is_nothrow_move_constructible_v< T > ) : small_vector() { take( std::move( other ) ); }
+		~small_vector() { clear(); free_heap(); }
+
+		small_vector& operator=( const small_vector& other ) { if ( this != &other ) assign( other.begin(), other.end() ); return *this; }
+		small_vector& operator=( small_vector&& other ) noexcept( std::is_nothrow_move_constructible_v< T > ) {
+			if ( this != &other ) { clear(); take( std::move( other ) ); }
+			return *this;
+		}
+		small_vector& operator=( std::initializer_list< T > il ) { assign( il.begin(), il.end() ); return *this; }
+
+		template< typename It > void assign( It first, It last ) {
+			clear();
+			if constexpr ( std::is_base_of_v< std::forward_iterator_tag, typename std::iterator_traits< It >::iterator_category > ) {
+				reserve( static_cast<size_t>( std::distance( first, last ) ) );
+				std::uninitialized_copy( first, last, data_ );
+				size_ = static_cast<size_t>( std::distance( first, last ) );
+			}
+			else for ( ; first != last; ++first )
+				emplace_back( *first );
+		}
 
-		small_vector() : end_( data_ ) {}
-		small_vector( size_t n, const T& v ) : end_( data_ + n ) { assign( v ); }
-		~small_vector() { for ( auto it = begin(); it != end(); ++it ) { it->~T(); } }
+		T& operator[]( index_t i ) { return data_[ i ]; }
+		const T& operator[]( index_t i ) const { return data_[ i ]; }
 
-		T& operator[]( index_t i ) { return *reinterpret_cast<T*>( data_ + i ); }
-		const T& operator[]( index_t i ) const { return *reinterpret_cast<const T*>( data_ + i ); }
+		T& at( index_t i ) { xo_error_if( i >= size(), "small_vector index out of bounds" ); return data_[ i ]; }
+		const T& at( index_t i ) const { xo_error_if( i >= size(), "small_vector index out of bounds" ); return data_[ i ]; }
 
-		T& at( size_t i ) { xo_error_if( i >= size(), "small_vector index out of bounds" ); return ( *this )[ i ]; }
-		const T& at( size_t i ) const { xo_error_if( i >= size(), "small_vector index out of bounds" ); ( *this )data_[ i ]; }
+		T& front() { return data_[ 0 ]; }
+		const T& front() const { return data_[ 0 ]; }
+		T& back() { return data_[ size_ - 1 ]; }
+		const T& back() const { return data_[ size_ - 1 ]; }
 
-		template<typename ...Args> void emplace_back( Args&&... args ) {
-			xo_error_if( size() >= N, "small_vector buffer overflow" );
-			new( end_ ) T( std::forward<Args>( args )... );	++end_;
+		template< typename... Args > T& emplace_back( Args&&... args ) {
+			if ( size_ == capacity_ ) {
+				// construct before reallocating, args may refer to an element of this vector
+				T tmp( std::forward< Args >( args )... );
+				grow( size_ + 1 );
+				new( data_ + size_ ) T( std::move( tmp ) );
+			}
+			else new( data_ + size_ ) T( std::forward< Args >( args )... );
+			return data_[ size_++ ];
 		}
+		void push_back( const T& e ) { emplace_back( e ); }
+		void push_back( T&& e ) { emplace_back( std::move( e ) ); }
+		void pop_back() { xo_assert( size_ > 0 ); data_[ --size_ ].~T(); }
 
-		void push_back( const T& e ) {
-			xo_error_if( size() >= N, "small_vector buffer overflow" ); *end_++ = e;
-			new( end_ ) e; ++end_;
+		/// insert element before pos, returns iterator to the inserted element
+		template< typename... Args > iterator emplace( const_iterator pos, Args&&... args ) {
+			auto idx = static_cast<size_t>( pos - begin() );
+			if ( idx == size_ ) {
+				emplace_back( std::forward< Args >( args )... );
+				return begin() + idx;
+			}
+			T tmp( std::forward< Args >( args )... );
+			if ( size_ == capacity_ )
+				grow( size_ + 1 );
+			if constexpr ( std::is_trivially_copyable_v< T > )
+				std::memmove( static_cast<void*>( data_ + idx + 1 ), data_ + idx, ( size_ - idx ) * sizeof( T ) );
+			else {
+				new( data_ + size_ ) T( std::move( data_[ size_ - 1 ] ) );
+				std::move_backward( data_ + idx, data_ + size_ - 1, data_ + size_ );
+				data_[ idx ].~T();
+			}
+			new( data_ + idx ) T( std::move( tmp ) );
+			++size_;
+			return begin() + idx;
 		}
+		iterator insert( const_iterator pos, const T& e ) { return emplace( pos, e ); }
+		iterator insert( const_iterator pos, T&& e ) { return emplace( pos, std::move( e ) ); }
 
-		void push_back( T&& e ) {
-			xo_error_if( size() >= N, "small_vector buffer overflow" ); *end_++ = std::move( e );
+		/// remove elements in [first, last), returns iterator to the element after the removed range
+		iterator erase( const_iterator first, const_iterator last ) {
+			auto b = begin() + ( first - begin() ), e = begin() + ( last - begin() );
+			if ( b != e ) {
+				auto new_end = std::move( e, end(), b );
+				destroy( new_end, end() );
+				size_ -= static_cast<size_t>( e - b );
+			}
+			return b;
 		}
+		iterator erase( const_iterator pos ) { return erase( pos, pos + 1 ); }
 
-		iterator begin() { return data(); }
-		const_iterator begin() const { return data(); }
-		const_iterator cbegin() const { return data(); }
+		void resize( size_t n ) {
+			reserve( n );
+			if ( n > size_ ) std::uninitialized_value_construct( data_ + size_, data_ + n );
+			else destroy( data_ + n, data_ + size_ );
+			size_ = n;
+		}
+		void resize( size_t n, const T& v ) {
+			if ( n > size_ ) {
+				if ( n > capacity_ ) {
+					T tmp( v ); // v may refer to an element of this vector
+					grow( n );
+					std::uninitialized_fill( data_ + size_, data_ + n, tmp );
+				}
+				else std::uninitialized_fill( data_ + size_, data_ + n, v );
+			}
+			else destroy( data_ + n, data_ + size_ );
+			size_ = n;
+		}
+
+		void reserve( size_t n ) { if ( n > capacity_ ) reallocate( n ); }
+		void clear() { destroy( begin(), end() ); size_ = 0; }
 
-		iterator end() { return end_; }
-		const_iterator end() const { return end_; }
-		const_iterator cend() const { return end_; }
+		iterator begin() { return data_; }
+		const_iterator begin() const { return data_; }
+		const_iterator cbegin() const { return data_; }
 
-		size_t size() const { return end() - begin(); }
+		iterator end() { return data_ + size_; }
+		const_iterator end() const { return data_ + size_; }
+		const_iterator cend() const { return data_ + size_; }
 
-		T* data() { return reinterpret_cast<T*>( data_ ); }
-		const T* data() const { return reinterpret_cast<const T*>( data_ ); }
+		size_t size() const { return size_; }
+		size_t capacity() const { return capacity_; }
+		bool empty() const { return size_ == 0; }
+
+		/// check if elements are stored in the inline buffer
+		bool is_inline() const { return data_ == inline_data(); }
+
+		T* data() { return data_; }
+		const T* data() const { return data_; }
 
 	private:
-		typename std::aligned_storage< sizeof( T ), alignof( T ) >::type data[ N ];
-		T* end_;
+		T* inline_data() { return reinterpret_cast<T*>( inline_ ); }
+		const T* inline_data() const { return reinterpret_cast<const T*>( inline_ ); }
+
+		static void destroy( T* b, T* e ) {
+			if constexpr ( !std::is_trivially_destructible_v< T > )
+				for ( ; b != e; ++b ) b->~T();
+		}
+
+		// move-construct n elements from src to uninitialized dst and destroy the originals
+		static void relocate( T* src, size_t n, T* dst ) {
+			if constexpr ( std::is_trivially_copyable_v< T > )
+				std::memcpy( static_cast<void*>( dst ), src, n * sizeof( T ) );
+			else {
+				std::uninitialized_move( src, src + n, dst );
+				destroy( src, src + n );
+			}
+		}
+
+		void grow( size_t min_capacity ) { reallocate( std::max( min_capacity, 2 * capacity_ ) ); }
+
+		void reallocate( size_t new_capacity ) {
+			auto* new_data = static_cast<T*>( ::operator new( new_capacity * sizeof( T ) ) );
+			relocate( data_, size_, new_data );
+			free_heap();
+			data_ = new_data;
+			capacity_ = new_capacity;
+		}
+
+		void free_heap() { if ( !is_inline() ) ::operator delete( data_ ); }
+
+		// take the contents of other, which must be empty, other is left empty
+		void take( small_vector&& other ) {
+			if ( other.is_inline() ) {
+				reserve( other.size_ );
+				relocate( other.data_, other.size_, data_ );
+			}
+			else {
+				free_heap();
+				data_ = other.data_;
+				capacity_ = other.capacity_;
+				other.data_ = other.inline_data();
+				other.capacity_ = N;
+			}
+			size_ = other.size_;
+			other.size_ = 0;
+		}
+
+		T* data_;
+		size_t size_;
+		size_t capacity_;
+		typename std::aligned_storage< sizeof( T ), alignof( T ) >::type inline_[ N > 0 ? N : 1 ];
 	};
+
+	template< typename T, size_t N1, size_t N2 >
+	bool operator==( const small_vector< T, N1 >& a, const small_vector< T, N2 >& b ) { return std::equal( a.begin(), a.end(), b.begin(), b.end() ); }
+	template< typename T, size_t N1, size_t N2 >
+	bool operator!=( const small_vector< T, N1 >& a, const small_vector< T, N2 >& b ) { return !( a == b ); }
 }
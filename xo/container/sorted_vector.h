@@ -1,5 +1,10 @@
 #pragma once
 
+#include "xo/container/container_tools.h"
+#include <algorithm>
+#include <functional>
+#include <vector>
+
 namespace xo
 {
 	template< typename T >
@@ -27,11 +32,26 @@ namespace xo
 
 		sorted_vector() : std::vector<T>() {}
 		sorted_vector( std::initializer_list< T > l ) : std::vector<T>( l ) { std::sort( begin(), end() ); }
+		template< typename It > sorted_vector( It first, It last ) : std::vector<T>( first, last ) { std::stable_sort( begin(), end() ); }
 
 		iterator insert( const T& e ) {
 			return std::vector< T >::insert( std::upper_bound( begin(), end(), e ), e );
 		}
 
+		/// insert range of unsorted values, which are sorted and merged in a single pass
+		template< typename It > void insert( It first, It last, duplicate_policy dp = duplicate_policy::keep_all ) {
+			auto mid = size();
+			std::vector< T >::insert( end(), first, last );
+			sort_merge_tail( vec(), mid, std::less< T >(), dp );
+		}
+
+		/// append value without sorting, commit_deferred() must be called before accessing the vector
+		void insert_deferred( const T& e ) { vec().push_back( e ); }
+		void insert_deferred( T&& e ) { vec().push_back( std::move( e ) ); }
+
+		/// sort and merge all values added with insert_deferred()
+		void commit_deferred( duplicate_policy dp = duplicate_policy::keep_all ) { sort_merge_unsorted_tail( vec(), std::less< T >(), dp ); }
+
 		iterator remove( const T& e ) {
 			iterator it = find( e );
 			if ( it != end() ) {
@@ -52,6 +72,9 @@ namespace xo
 			const_iterator it = std::lower_bound( cbegin(), cend(), e );
 			return ( it != cend() && *it == e ) ? it : cend();
 		}
+
+	private:
+		std::vector< T >& vec() { return *this; }
 	};
 
 	/// convert sorted_vector to string
@@ -7,6 +7,7 @@
 #include "xo/string/string_tools.h"
 #include "xo/serialization/char_stream.h"
 
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <ostream>
@@ -71,6 +72,27 @@ namespace xo
 			return idx == no_index ? add_channel( label, value ) : idx;
 		}
 
+		/// find or add a set of channels, the resulting indices can be cached for indexed access in frames
+		std::vector< index_t > find_or_add_channels( const std::vector< L >& labels, const T& value = T() ) {
+			// add all missing channels at once, so existing data is reorganized only once
+			std::vector< L > new_labels;
+			for ( const auto& l : labels )
+				if ( labels_.find( l ) == no_index && std::find( new_labels.begin(), new_labels.end(), l ) == new_labels.end() )
+					new_labels.push_back( l );
+			if ( !new_labels.empty() ) {
+				auto first_new = channel_size();
+				resize( frame_size(), channel_size() + new_labels.size(), value );
+				for ( index_t i = 0; i < new_labels.size(); ++i )
+					labels_.set( first_new + i, new_labels[ i ] );
+			}
+
+			std::vector< index_t > indices;
+			indices.reserve( labels.size() );
+			for ( const auto& l : labels )
+				indices.push_back( labels_.find( l ) );
+			return indices;
+		}
+
 		/// set channel label
 		void set_label( index_t channel, L label ) { labels_.set( channel, label ); }
 
@@ -114,7 +136,7 @@ namespace xo
 		frame back() { return frame( *this, frame_size() - 1 ); }
 
 		/// get the interpolated value of a specific frame / channel
-		T get_interpolated_value( T frame_idx, index_t channel ) {
+		T get_interpolated_value( T frame_idx, index_t channel ) const {
 			auto frame_f = floor( frame_idx );
 			auto frame_w = frame_idx - frame_f;
 			index_t frame0 = static_cast<index_t>( frame_f );
@@ -182,11 +204,11 @@ namespace xo
 		string line;
 		if ( std::getline( str, line ) )
 		{
-			for ( const auto& l : xo::split_str( line, "\t " ) )
-				sto.add_channel( l );
+			for ( auto l : xo::split_str_range( line, "\t " ) )
+				sto.add_channel( L( l ) );
 			while ( std::getline( str, line ) ) {
-				auto& f = sto.add_frame();
-				xo::char_stream cstr( line.c_str() );
+				auto f = sto.add_frame();
+				xo::char_stream cstr( std::move( line ) );
 				for ( index_t ci = 0; cstr.good() && ci < sto.channel_size(); ++ci )
 					cstr >> f[ ci ];
 			}
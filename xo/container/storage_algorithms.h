@@ -0,0 +1,318 @@
+#pragma once
+
+#include "xo/xo_types.h"
+#include "xo/container/storage.h"
+#include "xo/container/column_storage.h"
+#include "xo/thread/thread_pool.h"
+#include "xo/numerical/filter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace xo
+{
+	/// summary statistics of a single channel
+	template< typename T >
+	struct channel_statistics
+	{
+		T mean = T( 0 );
+		T std = T( 0 );
+		T min = std::numeric_limits< T >::max();
+		T max = std::numeric_limits< T >::lowest();
+	};
+
+	/// compute mean, standard deviation, min and max of all channels, channels are processed in parallel
+	template< typename T, typename L >
+	std::vector< channel_statistics< T > > compute_channel_statistics( const column_storage< T, L >& sto, thread_pool& pool = global_thread_pool() )
+	{
+		std::vector< channel_statistics< T > > result( sto.channel_size() );
+		const auto n = sto.frame_size();
+		if ( n == 0 )
+			return result;
+		pool.parallel_for( 0, sto.channel_size(), [&]( size_t cb, size_t ce ) {
+			for ( auto ci = cb; ci < ce; ++ci ) {
+				// branch-free loops with independent accumulators, which allows the compiler to vectorize
+				constexpr index_t lanes = 8;
+				const T* d = sto.channel_data( ci );
+				const index_t nv = n - n % lanes;
+				T sum[ lanes ] = {}, lo[ lanes ], hi[ lanes ], acc[ lanes ] = {};
+				std::fill_n( lo, lanes, d[ 0 ] );
+				std::fill_n( hi, lanes, d[ 0 ] );
+				for ( index_t fi = 0; fi < nv; fi += lanes ) {
+					for ( index_t l = 0; l < lanes; ++l ) {
+						sum[ l ] += d[ fi + l ];
+						lo[ l ] = d[ fi + l ] < lo[ l ] ? d[ fi + l ] : lo[ l ];
+						hi[ l ] = d[ fi + l ] > hi[ l ] ? d[ fi + l ] : hi[ l ];
+					}
+				}
+				for ( index_t fi = nv; fi < n; ++fi ) {
+					sum[ 0 ] += d[ fi ];
+					lo[ 0 ] = std::min( lo[ 0 ], d[ fi ] );
+					hi[ 0 ] = std::max( hi[ 0 ], d[ fi ] );
+				}
+				const T mean = std::accumulate( sum, sum + lanes, T( 0 ) ) / n;
+				for ( index_t fi = 0; fi < nv; fi += lanes )
+					for ( index_t l = 0; l < lanes; ++l )
+						acc[ l ] += ( d[ fi + l ] - mean ) * ( d[ fi + l ] - mean );
+				for ( index_t fi = nv; fi < n; ++fi )
+					acc[ 0 ] += ( d[ fi ] - mean ) * ( d[ fi ] - mean );
+				result[ ci ] = { mean, std::sqrt( std::accumulate( acc, acc + lanes, T( 0 ) ) / n ), *std::min_element( lo, lo + lanes ), *std::max_element( hi, hi + lanes ) };
+			}
+		} );
+		return result;
+	}
+
+	/// compute mean, standard deviation, min and max of all channels, frame ranges are processed in parallel
+	template< typename T, typename L >
+	std::vector< channel_statistics< T > > compute_channel_statistics( const storage< T, L >& sto, thread_pool& pool = global_thread_pool() )
+	{
+		const auto nc = sto.channel_size();
+		const auto nf = sto.frame_size();
+		std::vector< channel_statistics< T > > result( nc );
+		if ( nf == 0 || nc == 0 )
+			return result;
+
+		// each block accumulates a row of partial results, which are combined afterwards
+		const size_t num_blocks = std::min( pool.size() + 1, nf );
+		std::vector< T > sums( num_blocks * nc, T( 0 ) ), lows( num_blocks * nc ), highs( num_blocks * nc );
+		auto block_range = [&]( size_t bi ) { return std::make_pair( nf * bi / num_blocks, nf * ( bi + 1 ) / num_blocks ); };
+
+		pool.parallel_for( 0, num_blocks, [&]( size_t bb, size_t be ) {
+			for ( auto bi = bb; bi < be; ++bi ) {
+				auto [fb, fe] = block_range( bi );
+				T* sum = &sums[ bi * nc ], * lo = &lows[ bi * nc ], * hi = &highs[ bi * nc ];
+				std::copy( &sto( fb, 0 ), &sto( fb, 0 ) + nc, lo );
+				std::copy( &sto( fb, 0 ), &sto( fb, 0 ) + nc, hi );
+				for ( auto fi = fb; fi < fe; ++fi ) {
+					const T* d = &sto( fi, 0 );
+					for ( index_t ci = 0; ci < nc; ++ci ) {
+						sum[ ci ] += d[ ci ];
+						lo[ ci ] = d[ ci ] < lo[ ci ] ? d[ ci ] : lo[ ci ];
+						hi[ ci ] = d[ ci ] > hi[ ci ] ? d[ ci ] : hi[ ci ];
+					}
+				}
+			}
+		} );
+
+		std::vector< T > means( nc, T( 0 ) );
+		for ( index_t bi = 0; bi < num_blocks; ++bi ) {
+			for ( index_t ci = 0; ci < nc; ++ci ) {
+				means[ ci ] += sums[ bi * nc + ci ];
+				result[ ci ].min = std::min( result[ ci ].min, lows[ bi * nc + ci ] );
+				result[ ci ].max = std::max( result[ ci ].max, highs[ bi * nc + ci ] );
+			}
+		}
+		for ( auto& m : means )
+			m /= nf;
+
+		// second pass for squared deviations, re-using sums for the partial results
+		std::fill( sums.begin(), sums.end(), T( 0 ) );
+		pool.parallel_for( 0, num_blocks, [&]( size_t bb, size_t be ) {
+			for ( auto bi = bb; bi < be; ++bi ) {
+				auto [fb, fe] = block_range( bi );
+				T* acc = &sums[ bi * nc ];
+				for ( auto fi = fb; fi < fe; ++fi ) {
+					const T* d = &sto( fi, 0 );
+					for ( index_t ci = 0; ci < nc; ++ci )
+						acc[ ci ] += ( d[ ci ] - means[ ci ] ) * ( d[ ci ] - means[ ci ] );
+				}
+			}
+		} );
+
+		for ( index_t ci = 0; ci < nc; ++ci ) {
+			T acc = T( 0 );
+			for ( index_t bi = 0; bi < num_blocks; ++bi )
+				acc += sums[ bi * nc + ci ];
+			result[ ci ].mean = means[ ci ];
+			result[ ci ].std = std::sqrt( acc / nf );
+		}
+		return result;
+	}
+
+	/// get interpolated values of a channel at many (fractional) frame positions
+	template< typename S, typename T = typename S::value_type >
+	std::vector< T > get_interpolated_values( const S& sto, index_t channel, const std::vector< T >& frame_positions, thread_pool& pool = global_thread_pool() )
+	{
+		std::vector< T > result( frame_positions.size() );
+		pool.parallel_for( 0, frame_positions.size(), [&]( size_t b, size_t e ) {
+			for ( auto i = b; i < e; ++i )
+				result[ i ] = sto.get_interpolated_value( frame_positions[ i ], channel );
+		}, 1024 );
+		return result;
+	}
+
+	/// linearly resample storage to a new number of frames, frames are processed in parallel
+	template< typename T, typename L >
+	storage< T, L > resample( const storage< T, L >& sto, size_t frame_count, thread_pool& pool = global_thread_pool() )
+	{
+		xo_error_if( sto.frame_size() < 2 && frame_count > 0, "Cannot resample storage with less than two frames" );
+		const auto nc = sto.channel_size();
+		storage< T, L > result( frame_count, nc );
+		for ( index_t ci = 0; ci < nc; ++ci )
+			result.set_label( ci, sto.get_label( ci ) );
+		if ( nc == 0 )
+			return result;
+		const T scale = frame_count > 1 ? T( sto.frame_size() - 1 ) / T( frame_count - 1 ) : T( 0 );
+		pool.parallel_for( 0, frame_count, [&]( size_t b, size_t e ) {
+			for ( auto fi = b; fi < e; ++fi ) {
+				const T pos = fi * scale;
+				const index_t f0 = std::min( static_cast<index_t>( pos ), sto.frame_size() - 2 );
+				const T w = pos - f0;
+				const T* d0 = &sto( f0, 0 ), * d1 = d0 + nc;
+				T* r = &result( fi, 0 );
+				for ( index_t ci = 0; ci < nc; ++ci )
+					r[ ci ] = ( T( 1 ) - w ) * d0[ ci ] + w * d1[ ci ];
+			}
+		}, 256 );
+		return result;
+	}
+
+	/// linearly resample storage to a new number of frames, channels are processed in parallel
+	template< typename T, typename L >
+	column_storage< T, L > resample( const column_storage< T, L >& sto, size_t frame_count, thread_pool& pool = global_thread_pool() )
+	{
+		xo_error_if( sto.frame_size() < 2 && frame_count > 0, "Cannot resample storage with less than two frames" );
+		column_storage< T, L > result( frame_count, sto.channel_size() );
+		for ( index_t ci = 0; ci < sto.channel_size(); ++ci )
+			result.set_label( ci, sto.get_label( ci ) );
+		// interpolation indices and weights are shared by all channels
+		const T scale = frame_count > 1 ? T( sto.frame_size() - 1 ) / T( frame_count - 1 ) : T( 0 );
+		std::vector< index_t > idx( frame_count );
+		std::vector< T > weights( frame_count );
+		for ( index_t fi = 0; fi < frame_count; ++fi ) {
+			const T pos = fi * scale;
+			idx[ fi ] = std::min( static_cast<index_t>( pos ), sto.frame_size() - 2 );
+			weights[ fi ] = pos - idx[ fi ];
+		}
+		pool.parallel_for( 0, sto.channel_size(), [&]( size_t cb, size_t ce ) {
+			for ( auto ci = cb; ci < ce; ++ci ) {
+				const T* d = sto.channel_data( ci );
+				T* r = result.channel_data( ci );
+				for ( index_t fi = 0; fi < frame_count; ++fi )
+					r[ fi ] = ( T( 1 ) - weights[ fi ] ) * d[ idx[ fi ] ] + weights[ fi ] * d[ idx[ fi ] + 1 ];
+			}
+		} );
+		return result;
+	}
+
+	/// apply a copy of filter (e.g. iir_filter) to each channel in-place, channels are processed in parallel
+	template< typename S, typename F >
+	void filter_channels( S& sto, const F& filter, thread_pool& pool = global_thread_pool() )
+	{
+		pool.parallel_for( 0, sto.channel_size(), [&]( size_t cb, size_t ce ) {
+			// frames in the outer loop, so that row-major storage is traversed in memory order
+			std::vector< F > filters( ce - cb, filter );
+			for ( index_t fi = 0; fi < sto.frame_size(); ++fi )
+				for ( auto ci = cb; ci < ce; ++ci )
+					sto( fi, ci ) = filters[ ci - cb ]( sto( fi, ci ) );
+		} );
+	}
+
+	/// apply filter to each channel in-place, using a filter bank of type B (e.g. iir_filter_bank) per block of channels
+	/// each channel starts with the state of filter, as in filter_channels()
+	template< typename B, typename T, typename L, typename F >
+	void filter_channels_with_bank( storage< T, L >& sto, const F& filter, thread_pool& pool = global_thread_pool() )
+	{
+		if ( sto.frame_size() == 0 )
+			return;
+		const auto nc = sto.channel_size();
+		pool.parallel_for( 0, nc, [&]( size_t cb, size_t ce ) {
+			B bank( filter, ce - cb );
+			bank.process( &sto( 0, cb ), &sto( 0, cb ), sto.frame_size(), nc, nc );
+		}, B::lanes );
+	}
+
+	/// apply filter to each channel in-place, frames are processed in tiles that are transposed
+	/// to frame-major order, so that a filter bank of type B can process multiple channels at once
+	template< typename B, typename T, typename L, typename F >
+	void filter_channels_with_bank( column_storage< T, L >& sto, const F& filter, thread_pool& pool = global_thread_pool() )
+	{
+		constexpr size_t tile_frames = 256;
+		constexpr size_t lanes = B::lanes;
+		pool.parallel_for( 0, sto.channel_size(), [&]( size_t cb, size_t ce ) {
+			std::vector< T > tile( tile_frames * lanes );
+			for ( auto c0 = cb; c0 < ce; c0 += lanes ) {
+				const auto nc = std::min( lanes, ce - c0 );
+				B bank( filter, nc );
+				for ( size_t f0 = 0; f0 < sto.frame_size(); f0 += tile_frames ) {
+					const auto nf = std::min( tile_frames, sto.frame_size() - f0 );
+					for ( size_t c = 0; c < nc; ++c ) {
+						const T* src = sto.channel_data( c0 + c ) + f0;
+						for ( size_t f = 0; f < nf; ++f )
+							tile[ f * nc + c ] = src[ f ];
+					}
+					bank.process( tile.data(), tile.data(), nf );
+					for ( size_t c = 0; c < nc; ++c ) {
+						T* dst = sto.channel_data( c0 + c ) + f0;
+						for ( size_t f = 0; f < nf; ++f )
+							dst[ f ] = tile[ f * nc + c ];
+					}
+				}
+			}
+		}, lanes );
+	}
+
+	/// apply iir_filter to each channel in-place, using an iir_filter_bank per block of channels
+	template< typename T, typename L, int N >
+	void filter_channels( storage< T, L >& sto, const iir_filter< T, N >& filter, thread_pool& pool = global_thread_pool() )
+	{ filter_channels_with_bank< iir_filter_bank< T, N > >( sto, filter, pool ); }
+
+	/// apply iir_filter to each channel in-place, using an iir_filter_bank on transposed tiles
+	template< typename T, typename L, int N >
+	void filter_channels( column_storage< T, L >& sto, const iir_filter< T, N >& filter, thread_pool& pool = global_thread_pool() )
+	{ filter_channels_with_bank< iir_filter_bank< T, N > >( sto, filter, pool ); }
+
+	/// apply sos_filter to each channel in-place, using an sos_filter_bank per block of channels
+	template< typename T, typename L >
+	void filter_channels( storage< T, L >& sto, const sos_filter< T >& filter, thread_pool& pool = global_thread_pool() )
+	{ filter_channels_with_bank< sos_filter_bank< T > >( sto, filter, pool ); }
+
+	/// apply sos_filter to each channel in-place, using an sos_filter_bank on transposed tiles
+	template< typename T, typename L >
+	void filter_channels( column_storage< T, L >& sto, const sos_filter< T >& filter, thread_pool& pool = global_thread_pool() )
+	{ filter_channels_with_bank< sos_filter_bank< T > >( sto, filter, pool ); }
+
+	/// apply sos_filter to each channel forward and backward in-place, resulting in zero phase shift
+	/// see sos_filter::process_zero_phase(); channels are processed in-place by an sos_filter_bank per block of channels
+	template< typename T, typename L >
+	void filter_channels_zero_phase( storage< T, L >& sto, const sos_filter< T >& filter, thread_pool& pool = global_thread_pool() )
+	{
+		if ( sto.frame_size() == 0 )
+			return;
+		const auto nc = sto.channel_size();
+		pool.parallel_for( 0, nc, [&]( size_t cb, size_t ce ) {
+			sos_filter_bank< T > bank( filter, ce - cb );
+			bank.process_zero_phase( &sto( 0, cb ), sto.frame_size(), nc );
+		}, sos_filter_bank< T >::lanes );
+	}
+
+	/// apply sos_filter to each channel forward and backward in-place, resulting in zero phase shift
+	/// blocks of channels are transposed to frame-major order, so that an sos_filter_bank can process them at once
+	template< typename T, typename L >
+	void filter_channels_zero_phase( column_storage< T, L >& sto, const sos_filter< T >& filter, thread_pool& pool = global_thread_pool() )
+	{
+		constexpr size_t lanes = sos_filter_bank< T >::lanes;
+		const auto nf = sto.frame_size();
+		pool.parallel_for( 0, sto.channel_size(), [&]( size_t cb, size_t ce ) {
+			std::vector< T > buf( nf * lanes );
+			for ( auto c0 = cb; c0 < ce; c0 += lanes ) {
+				const auto nc = std::min( lanes, ce - c0 );
+				for ( size_t c = 0; c < nc; ++c ) {
+					const T* src = sto.channel_data( c0 + c );
+					for ( size_t f = 0; f < nf; ++f )
+						buf[ f * nc + c ] = src[ f ];
+				}
+				sos_filter_bank< T > bank( filter, nc );
+				bank.process_zero_phase( buf.data(), nf, nc );
+				for ( size_t c = 0; c < nc; ++c ) {
+					T* dst = sto.channel_data( c0 + c );
+					for ( size_t f = 0; f < nf; ++f )
+						dst[ f ] = buf[ f * nc + c ];
+				}
+			}
+		}, lanes );
+	}
+}
@@ -0,0 +1,251 @@
+#pragma once
+
+#include "xo/xo_types.h"
+#include "xo/container/storage.h"
+#include "xo/container/label_vector.h"
+#include "xo/filesystem/path.h"
+#include "xo/filesystem/memory_mapped_file.h"
+#include "xo/system/error_code.h"
+
+#include <cstring>
+#include <fstream>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace xo
+{
+	/// header of binary storage files: labels follow the header, data is stored channel-major,
+	/// with each channel starting at a 64-byte aligned offset and frame_stride values per channel
+	struct storage_file_header
+	{
+		char magic[ 8 ];
+		uint32 version;
+		uint32 value_size;
+		uint32 value_type; // 1 = floating point, 2 = signed integer, 3 = unsigned integer
+		uint32 reserved;
+		uint64 frame_count;
+		uint64 channel_count;
+		uint64 frame_stride;
+		uint64 labels_offset;
+		uint64 data_offset;
+	};
+
+	constexpr const char storage_file_magic[ 8 ] = { 'x', 'o', 's', 't', 'o', 'r', 'e', '\0' };
+	constexpr uint32 storage_file_version = 1;
+	constexpr uint64 storage_file_alignment = 64;
+
+	template< typename T > constexpr uint32 storage_file_value_type() {
+		static_assert( std::is_arithmetic_v< T >, "Binary storage files only support arithmetic types" );
+		return std::is_floating_point_v< T > ? 1 : std::is_signed_v< T > ? 2 : 3;
+	}
+
+	constexpr uint64 storage_file_align( uint64 ofs ) {
+		return ( ofs + storage_file_alignment - 1 ) / storage_file_alignment * storage_file_alignment;
+	}
+
+	/// write storage (or column_storage / chunked_storage) to a binary storage file
+	template< typename S > bool save_storage_binary( const S& sto, const path& filename, error_code* ec = nullptr ) {
+		using T = typename S::value_type;
+		std::ofstream str( filename.str(), std::ios::binary );
+		if ( !str.good() )
+			return set_error_or_throw( ec, "Could not open " + filename.str() ), false;
+
+		storage_file_header h{};
+		std::memcpy( h.magic, storage_file_magic, sizeof( h.magic ) );
+		h.version = storage_file_version;
+		h.value_size = sizeof( T );
+		h.value_type = storage_file_value_type< T >();
+		h.frame_count = sto.frame_size();
+		h.channel_count = sto.channel_size();
+		h.frame_stride = storage_file_align( h.frame_count * sizeof( T ) ) / sizeof( T );
+		h.labels_offset = sizeof( storage_file_header );
+
+		// compute data offset from label size
+		uint64 labels_size = 0;
+		for ( index_t ci = 0; ci < sto.channel_size(); ++ci )
+			labels_size += sizeof( uint32 ) + sto.get_label( ci ).size();
+		h.data_offset = storage_file_align( h.labels_offset + labels_size );
+		str.write( reinterpret_cast<const char*>( &h ), sizeof( h ) );
+
+		for ( index_t ci = 0; ci < sto.channel_size(); ++ci ) {
+			const auto& label = sto.get_label( ci );
+			auto len = static_cast<uint32>( label.size() );
+			str.write( reinterpret_cast<const char*>( &len ), sizeof( len ) );
+			str.write( label.data(), len );
+		}
+
+		std::vector< char > padding( h.data_offset - h.labels_offset - labels_size, 0 );
+		str.write( padding.data(), padding.size() );
+
+		std::vector< T > channel( h.frame_stride, T( 0 ) );
+		for ( index_t ci = 0; ci < sto.channel_size(); ++ci ) {
+			for ( index_t fi = 0; fi < sto.frame_size(); ++fi )
+				channel[ fi ] = sto( fi, ci );
+			str.write( reinterpret_cast<const char*>( channel.data() ), channel.size() * sizeof( T ) );
+		}
+
+		if ( !str.good() )
+			return set_error_or_throw( ec, "Error writing " + filename.str() ), false;
+		return true;
+	}
+
+	/// read-only view of a memory mapped binary storage file, data is accessed without copying
+	template< typename T >
+	class mapped_storage
+	{
+	public:
+		using value_type = T;
+		using label_type = string;
+
+		struct const_frame {
+			const_frame( const mapped_storage< T >& s, index_t f ) : sto_( s ), fidx_( f ) {}
+			const T& operator[]( index_t i ) const { return sto_( fidx_, i ); }
+			const T& operator[]( const string& l ) const { return sto_( fidx_, sto_.find_channel( l ) ); }
+			const mapped_storage< T >& sto_;
+			index_t fidx_;
+		};
+
+		mapped_storage() : frame_size_( 0 ), frame_stride_( 0 ), data_( nullptr ) {}
+		explicit mapped_storage( const path& filename, error_code* ec = nullptr ) : mapped_storage() {
+			file_ = memory_mapped_file( filename, ec );
+			if ( !file_.is_open() )
+				return;
+
+			storage_file_header h;
+			if ( file_.size() < sizeof( h ) )
+				{ close_with_error( ec, "Invalid storage file: " + filename.str() ); return; }
+			std::memcpy( &h, file_.data(), sizeof( h ) );
+			if ( std::memcmp( h.magic, storage_file_magic, sizeof( h.magic ) ) != 0 || h.version != storage_file_version )
+				{ close_with_error( ec, "Invalid storage file: " + filename.str() ); return; }
+			if ( h.value_size != sizeof( T ) || h.value_type != storage_file_value_type< T >() )
+				{ close_with_error( ec, "Storage file value type does not match: " + filename.str() ); return; }
+			if ( h.frame_count > h.frame_stride || h.labels_offset < sizeof( h ) || h.labels_offset > h.data_offset || h.data_offset % storage_file_alignment != 0 )
+				{ close_with_error( ec, "Invalid storage file layout: " + filename.str() ); return; }
+
+			// check that all channels fit in the file, without overflowing channel_count * frame_stride * sizeof( T )
+			const uint64 data_capacity = h.data_offset <= file_.size() ? ( file_.size() - h.data_offset ) / sizeof( T ) : 0;
+			if ( h.data_offset > file_.size() || ( h.frame_stride > 0 && h.channel_count > data_capacity / h.frame_stride ) )
+				{ close_with_error( ec, "Storage file is truncated: " + filename.str() ); return; }
+
+			const char* p = file_.data() + h.labels_offset;
+			const char* labels_end = file_.data() + h.data_offset;
+			for ( index_t ci = 0; ci < h.channel_count; ++ci ) {
+				uint32 len;
+				if ( p + sizeof( len ) > labels_end )
+					{ close_with_error( ec, "Invalid storage file labels: " + filename.str() ); return; }
+				std::memcpy( &len, p, sizeof( len ) );
+				p += sizeof( len );
+				if ( p + len > labels_end )
+					{ close_with_error( ec, "Invalid storage file labels: " + filename.str() ); return; }
+				labels_.add( string( p, len ) );
+				p += len;
+			}
+			frame_size_ = size_t( h.frame_count );
+			frame_stride_ = size_t( h.frame_stride );
+			data_ = reinterpret_cast<const T*>( file_.data() + h.data_offset );
+		}
+
+		bool is_open() const { return data_ != nullptr; }
+
+		/// number of channels
+		size_t channel_size() const { return labels_.size(); }
+
+		/// number of frames in storage
+		size_t frame_size() const { return frame_size_; }
+
+		/// check if there is any data
+		bool empty() const { return frame_size_ == 0 || channel_size() == 0; }
+
+		/// find index of a label
+		index_t find_channel( const string& label ) const { return labels_.find_or_throw( label ); }
+
+		/// find index of a label
+		index_t try_find_channel( const string& label ) const { return labels_.find( label ); }
+
+		/// get channel label
+		const string& get_label( index_t channel ) const { return labels_[ channel ]; }
+
+		/// access value (no bounds checking)
+		const T& operator()( index_t frame, index_t channel ) const { return data_[ channel * frame_stride_ + frame ]; }
+
+		/// contiguous, 64-byte aligned data of a channel, with frame_size() elements
+		const T* channel_data( index_t channel ) const { return data_ + channel * frame_stride_; }
+
+		/// access frame
+		const_frame operator[]( index_t f ) const { return const_frame( *this, f ); }
+		const_frame front() const { return const_frame( *this, 0 ); }
+		const_frame back() const { return const_frame( *this, frame_size() - 1 ); }
+
+		std::vector<T> get_channel( index_t channel ) const {
+			return std::vector<T>( channel_data( channel ), channel_data( channel ) + frame_size() );
+		}
+		std::vector<T> get_channel( const string& label ) const { return get_channel( find_channel( label ) ); }
+
+		const label_vector< string >& labels() const { return labels_; }
+
+	private:
+		void close_with_error( error_code* ec, const string& message ) {
+			file_.close();
+			set_error_or_throw( ec, message );
+		}
+
+		memory_mapped_file file_;
+		label_vector< string > labels_;
+		size_t frame_size_;
+		size_t frame_stride_;
+		const T* data_;
+	};
+
+	/// load binary storage file into a storage
+	template< typename T > storage< T > load_storage_binary( const path& filename, error_code* ec = nullptr ) {
+		storage< T > sto;
+		mapped_storage< T > ms( filename, ec );
+		if ( ms.is_open() ) {
+			sto.resize( ms.frame_size(), ms.channel_size() );
+			for ( index_t ci = 0; ci < ms.channel_size(); ++ci ) {
+				sto.set_label( ci, ms.get_label( ci ) );
+				const T* src = ms.channel_data( ci );
+				for ( index_t fi = 0; fi < ms.frame_size(); ++fi )
+					sto( fi, ci ) = src[ fi ];
+			}
+		}
+		return sto;
+	}
+
+	/// convert tab-separated text storage file to binary storage file
+	template< typename T > bool convert_storage_text_to_binary( const path& text_file, const path& binary_file, error_code* ec = nullptr ) {
+		std::ifstream str( text_file.str() );
+		if ( !str.good() )
+			return set_error_or_throw( ec, "Could not open " + text_file.str() ), false;
+		storage< T > sto;
+		str >> sto;
+		return save_storage_binary( sto, binary_file, ec );
+	}
+
+	/// convert binary storage file to tab-separated text storage file
+	template< typename T > bool convert_storage_binary_to_text( const path& binary_file, const path& text_file, error_code* ec = nullptr ) {
+		mapped_storage< T > ms( binary_file, ec );
+		if ( !ms.is_open() )
+			return false;
+		std::ofstream str( text_file.str() );
+		if ( !str.good() )
+			return set_error_or_throw( ec, "Could not open " + text_file.str() ), false;
+		str << ms;
+		return str.good();
+	}
+
+	template< typename T > std::ostream& operator<<( std::ostream& str, const mapped_storage< T >& buf ) {
+		for ( index_t ci = 0; ci < buf.channel_size(); ++ci ) {
+			str << buf.get_label( ci );
+			if ( ci == buf.channel_size() - 1 ) str << std::endl; else str << '\t';
+		}
+		for ( index_t fi = 0; fi < buf.frame_size(); ++fi ) {
+			for ( index_t ci = 0; ci < buf.channel_size(); ++ci ) {
+				str << buf( fi, ci );
+				if ( ci == buf.channel_size() - 1 ) str << std::endl; else str << '\t';
+			}
+		}
+		return str;
+	}
+}
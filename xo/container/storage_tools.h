@@ -48,6 +48,48 @@ namespace xo
 		else return first;
 	}
 
+	/// channel indices of a vec3, resolve once using find_or_add_vec3_channels() and reuse for each frame
+	struct vec3_channels { index_t x, y, z; };
+
+	/// channel indices of a quat, resolve once using find_or_add_quat_channels() and reuse for each frame
+	struct quat_channels { index_t w, x, y, z; };
+
+	template< typename T > vec3_channels find_or_add_vec3_channels( storage< T >& sto, const string& str ) {
+		auto idx = sto.find_or_add_channels( { str + ".x", str + ".y", str + ".z" } );
+		return { idx[ 0 ], idx[ 1 ], idx[ 2 ] };
+	}
+
+	template< typename T > quat_channels find_or_add_quat_channels( storage< T >& sto, const string& str ) {
+		auto idx = sto.find_or_add_channels( { str + ".w", str + ".x", str + ".y", str + ".z" } );
+		return { idx[ 0 ], idx[ 1 ], idx[ 2 ], idx[ 3 ] };
+	}
+
+	template< typename T > void write( const typename storage<T>::frame& f, const vec3_channels& c, const vec3_<T>& v ) {
+		f[ c.x ] = v.x;
+		f[ c.y ] = v.y;
+		f[ c.z ] = v.z;
+	}
+
+	template< typename T > void write( const typename storage<T>::frame& f, const quat_channels& c, const quat_<T>& q ) {
+		f[ c.w ] = q.w;
+		f[ c.x ] = q.x;
+		f[ c.y ] = q.y;
+		f[ c.z ] = q.z;
+	}
+
+	template< typename T > void read( const typename storage<T>::const_frame& f, const vec3_channels& c, vec3_<T>& v ) {
+		v.x = f[ c.x ];
+		v.y = f[ c.y ];
+		v.z = f[ c.z ];
+	}
+
+	template< typename T > void read( const typename storage<T>::const_frame& f, const quat_channels& c, quat_<T>& q ) {
+		q.w = f[ c.w ];
+		q.x = f[ c.x ];
+		q.y = f[ c.y ];
+		q.z = f[ c.z ];
+	}
+
 	template< typename T > void write( typename storage<T>::frame& f, const string& str, const vec3_<T>& v ) {
 		f[ str + ".x" ] = v.x;
 		f[ str + ".y" ] = v.y;
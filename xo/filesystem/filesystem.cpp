@@ -89,7 +89,14 @@ namespace xo
 
 	path temp_directory_path()
 	{
-		return path( std::getenv( "TMP" ) );
+		for ( auto* var : { "TMP", "TMPDIR", "TEMP" } )
+			if ( auto* dir = std::getenv( var ) )
+				return path( dir );
+#ifdef XO_COMP_MSVC
+		return path( "C:/Windows/Temp" );
+#else
+		return path( "/tmp" );
+#endif
 	}
 
 	bool copy_file( const path& from, const path& to, bool overwrite )
@@ -0,0 +1,104 @@
+#include "memory_mapped_file.h"
+
+#ifdef XO_COMP_MSVC
+#	define NOMINMAX
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+#include <utility>
+
+namespace xo
+{
+	memory_mapped_file::memory_mapped_file( const path& filename, error_code* ec ) :
+		data_( nullptr ), size_( 0 ), handle_( nullptr )
+	{
+#ifdef XO_COMP_MSVC
+		HANDLE file = CreateFileA( filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+		if ( file == INVALID_HANDLE_VALUE )
+		{
+			set_error_or_throw( ec, "Could not open " + filename.str() );
+			return;
+		}
+		LARGE_INTEGER file_size;
+		if ( GetFileSizeEx( file, &file_size ) && file_size.QuadPart > 0 )
+		{
+			if ( HANDLE mapping = CreateFileMappingA( file, NULL, PAGE_READONLY, 0, 0, NULL ) )
+			{
+				data_ = static_cast<const char*>( MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 ) );
+				if ( data_ )
+				{
+					size_ = size_t( file_size.QuadPart );
+					handle_ = mapping;
+				}
+				else CloseHandle( mapping );
+			}
+		}
+		CloseHandle( file );
+#else
+		int fd = ::open( filename.c_str(), O_RDONLY );
+		if ( fd == -1 )
+		{
+			set_error_or_throw( ec, "Could not open " + filename.str() );
+			return;
+		}
+		struct stat st;
+		if ( fstat( fd, &st ) == 0 && st.st_size > 0 )
+		{
+			void* p = mmap( nullptr, size_t( st.st_size ), PROT_READ, MAP_SHARED, fd, 0 );
+			if ( p != MAP_FAILED )
+			{
+				data_ = static_cast<const char*>( p );
+				size_ = size_t( st.st_size );
+			}
+		}
+		::close( fd );
+#endif
+		if ( !data_ )
+			set_error_or_throw( ec, "Could not map " + filename.str() );
+	}
+
+	memory_mapped_file::memory_mapped_file( memory_mapped_file&& other ) noexcept :
+		data_( std::exchange( other.data_, nullptr ) ),
+		size_( std::exchange( other.size_, 0 ) ),
+		handle_( std::exchange( other.handle_, nullptr ) )
+	{}
+
+	memory_mapped_file& memory_mapped_file::operator=( memory_mapped_file&& other ) noexcept
+	{
+		if ( this != &other )
+		{
+			close();
+			data_ = std::exchange( other.data_, nullptr );
+			size_ = std::exchange( other.size_, 0 );
+			handle_ = std::exchange( other.handle_, nullptr );
+		}
+		return *this;
+	}
+
+	memory_mapped_file::~memory_mapped_file()
+	{
+		close();
+	}
+
+	void memory_mapped_file::close()
+	{
+		if ( data_ )
+		{
+#ifdef XO_COMP_MSVC
+			UnmapViewOfFile( data_ );
+			CloseHandle( static_cast<HANDLE>( handle_ ) );
+#else
+			munmap( const_cast<char*>( data_ ), size_ );
+#endif
+			data_ = nullptr;
+			size_ = 0;
+			handle_ = nullptr;
+		}
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "xo/xo_types.h"
+#include "xo/filesystem/path.h"
+#include "xo/system/error_code.h"
+
+namespace xo
+{
+	/// read-only memory mapped file
+	class XO_API memory_mapped_file
+	{
+	public:
+		memory_mapped_file() : data_( nullptr ), size_( 0 ), handle_( nullptr ) {}
+		explicit memory_mapped_file( const path& filename, error_code* ec = nullptr );
+		memory_mapped_file( memory_mapped_file&& other ) noexcept;
+		memory_mapped_file& operator=( memory_mapped_file&& other ) noexcept;
+		memory_mapped_file( const memory_mapped_file& ) = delete;
+		memory_mapped_file& operator=( const memory_mapped_file& ) = delete;
+		~memory_mapped_file();
+
+		const char* data() const { return data_; }
+		size_t size() const { return size_; }
+		bool is_open() const { return data_ != nullptr; }
+		void close();
+
+	private:
+		const char* data_;
+		size_t size_;
+		void* handle_; // file mapping handle, only used on Windows
+	};
+}
@@ -111,7 +111,12 @@ namespace xo
 	path& path::operator/=( const string_type& p )
 	{
 		if ( has_filename() )
-			data_ += preferred_separator + trim_left_str( p, "/\\" );
+		{
+			auto tail = trim_left_str( std::string_view( p ), "/\\" );
+			data_.reserve( data_.size() + 1 + tail.size() );
+			data_ += preferred_separator;
+			data_ += tail;
+		}
 		else data_ += p;
 		return *this;
 	}
@@ -9,22 +9,28 @@ namespace xo
 	struct dynmat
 	{
 		using value_type = T;
-		using iterator = typename dynarray< T >::iterator;
-		using const_iterator = typename dynarray< T >::const_iterator;
+		using storage_type = dynarray< T, 64 >; // aligned for SIMD loads
+		using iterator = typename storage_type::iterator;
+		using const_iterator = typename storage_type::const_iterator;
 
 		dynmat() : cols_(), data_() {}
 		dynmat( size_t col, size_t row, const T& value = T() ) : cols_( col ), data_( row * col, value ) {}
+		dynmat( size_t col, size_t row, default_init_t ) : cols_( col ), data_( row * col, default_init ) {}
 
 		const T& operator()( index_t col, index_t row ) const { return data_[ row * cols_ + col ]; }
 		T& operator()( index_t col, index_t row ) { return data_[ row * cols_ + col ]; }
 
-		void resize( size_t newcols, size_t newrows ) {
-			dynmat<T> newmat( newcols, newrows, T() );
-			auto rmin = xo::min( rows(), newrows );
-			auto cmin = xo::min( cols(), newcols );
-			for ( auto r = 0; r < rmin; ++r )
-				for ( auto c = 0; c < cmin; ++c )
-					newmat( c, r ) = (*this)( c, r );
+		/// resize matrix, existing elements are kept and new elements are set to value
+		void resize( size_t newcols, size_t newrows, const T& value = T() ) {
+			if ( newcols == cols_ ) {
+				data_.resize( newcols * newrows, value );
+				return;
+			}
+			dynmat<T> newmat( newcols, newrows, value );
+			auto rmin = std::min( rows(), newrows );
+			auto cmin = std::min( cols(), newcols );
+			for ( index_t r = 0; r < rmin; ++r )
+				std::copy( row_data( r ), row_data( r ) + cmin, newmat.row_data( r ) );
 			*this = std::move( newmat );
 		}
 
@@ -34,6 +40,11 @@ namespace xo
 		size_t cols() const { return cols_; }
 		size_t rows() const { return empty() ? 0 : data_.size() / cols_; }
 
+		T* data() { return data_.data(); }
+		const T* data() const { return data_.data(); }
+		T* row_data( index_t row ) { return data_.data() + row * cols_; }
+		const T* row_data( index_t row ) const { return data_.data() + row * cols_; }
+
 		iterator begin() { return data_.begin(); }
 		const_iterator begin() const { return data_.begin(); }
 		const_iterator cbegin() const { return data_.cbegin(); }
@@ -44,18 +55,20 @@ namespace xo
 
 	private:
 		size_t cols_;
-		dynarray< T > data_;
+		storage_type data_;
 	};
 
 	template< typename T > dynvec< T > operator*( const dynmat< T >& m, const dynvec< T >& v )
 	{
-		flut_assert( m.cols() == v.size() );
-		dynvec< T > r( m.rows() );
+		xo_assert( m.cols() == v.size() );
+		dynvec< T > r( m.rows(), default_init );
+		const T* vd = v.data();
 		for ( index_t row = 0; row < m.rows(); ++row )
 		{
-			T sum = 0.0;
+			const T* md = m.row_data( row );
+			T sum = T( 0 );
 			for ( index_t col = 0; col < m.cols(); ++col )
-				sum += m( row, col ) * v[ col ];
+				sum += md[ col ] * vd[ col ];
 			r[ row ] = sum;
 		}
 		return r;
@@ -3,6 +3,9 @@
 #include "xo/system/assert.h"
 #include "xo/utility/pointer_iterator.h"
 #include "xo/container/dynarray.h"
+#include "xo/numerical/compare.h"
+#include "xo/numerical/math.h"
+#include <cmath>
 
 namespace xo
 {
@@ -11,11 +14,13 @@ namespace xo
 		using value_type = T;
 		using iterator = pointer_iterator< T >;
 		using const_iterator = pointer_iterator< const T >;
+		using storage_type = dynarray< T, 64 >; // aligned for SIMD loads
 
 		/// construction
 		dynvec() : data_() {}
 		dynvec( size_t n ) : data_( n ) {}
 		dynvec( size_t n, const T& v ) : data_( n, v ) {}
+		dynvec( size_t n, default_init_t ) : data_( n, default_init ) {}
 		dynvec( const dynvec<T>& o ) : data_( o.data_ ) {}
 		dynvec( dynvec<T>&& o ) : data_( std::move( o.data_ ) ) {}
 
@@ -30,19 +35,22 @@ namespace xo
 		iterator end() { return data_.end(); }
 		const_iterator begin() const { return data_.begin(); }
 		const_iterator end() const { return data_.end(); }
+		T* data() { return data_.data(); }
+		const T* data() const { return data_.data(); }
 
-		// resize
+		// resize, existing elements are kept
 		void resize( size_t n, const T& v = T() ) { data_.resize( n, v ); }
+		void resize( size_t n, default_init_t ) { data_.resize( n, default_init ); }
 
 		/// properties
 		size_t size() const { return end() - begin(); }
 		bool empty() const { return begin() == end(); }
 		T length() const { return sqrt( squared_length() ); }
 		T squared_length() const { T sum = T(); for ( auto& e : data_ ) sum += e * e; return sum; }
-		bool is_null() const { return for ( auto& e : data_ ) if ( e != T( 0 ) ) return false; return true; }
+		bool is_null() const { for ( auto& e : data_ ) if ( e != T( 0 ) ) return false; return true; }
 
 	private:
-		dynarray< T > data_;
+		storage_type data_;
 	};
 
 	/// template instantiations
@@ -59,17 +67,21 @@ namespace xo
 	template< typename T > dynvec<T> operator+( const dynvec<T>& v1, const dynvec<T>& v2 )
 	{
 		xo_assert( v1.size() == v2.size() );
-		dynvec<T> r( v1.size() );
+		dynvec<T> r( v1.size(), default_init );
+		const T* a = v1.data(), *b = v2.data();
+		T* d = r.data();
 		for ( index_t i = 0; i < r.size(); ++i )
-			r[ i ] = v1[ i ] + v2[ i ];
+			d[ i ] = a[ i ] + b[ i ];
 		return r;
 	}
 	/// Addition
 	template< typename T > dynvec<T>& operator+=( dynvec<T>& v1, const dynvec<T>& v2 )
 	{
 		xo_assert( v1.size() == v2.size() );
-		for ( index_t i = 0; i < r.size(); ++i )
-			v1[ i ] += v2[ i ];
+		T* d = v1.data();
+		const T* b = v2.data();
+		for ( index_t i = 0; i < v1.size(); ++i )
+			d[ i ] += b[ i ];
 		return v1;
 	}
 
@@ -77,17 +89,21 @@ namespace xo
 	template< typename T > dynvec<T> operator-( const dynvec<T>& v1, const dynvec<T>& v2 )
 	{
 		xo_assert( v1.size() == v2.size() );
-		dynvec<T> r( v1.size() );
+		dynvec<T> r( v1.size(), default_init );
+		const T* a = v1.data(), *b = v2.data();
+		T* d = r.data();
 		for ( index_t i = 0; i < r.size(); ++i )
-			r[ i ] = v1[ i ] - v2[ i ];
+			d[ i ] = a[ i ] - b[ i ];
 		return r;
 	}
 	/// Subtraction
 	template< typename T > dynvec<T>& operator-=( dynvec<T>& v1, const dynvec<T>& v2 )
 	{
 		xo_assert( v1.size() == v2.size() );
-		for ( index_t i = 0; i < r.size(); ++i )
-			v1[ i ] -= v2[ i ];
+		T* d = v1.data();
+		const T* b = v2.data();
+		for ( index_t i = 0; i < v1.size(); ++i )
+			d[ i ] -= b[ i ];
 		return v1;
 	}
 
@@ -103,8 +119,11 @@ namespace xo
 	template< typename T > dynvec<T> operator/( dynvec<T> v, T s ) { return v * inv( s ); }
 	template< typename T > dynvec<T>& operator/=( dynvec<T>& v, T s ) { return v *= inv( s ); }
 
-	/// Test if a vec3 is of unit length
-	template< typename T > T is_normalized( const dynvec<T>& v ) { return equal( v.length(), T( 1 ) ); }
+	/// Get length of a dynvec
+	template< typename T > T length( const dynvec<T>& v ) { return v.length(); }
+
+	/// Test if a dynvec is of unit length
+	template< typename T > bool is_normalized( const dynvec<T>& v ) { return equal( v.length(), T( 1 ) ); }
 
 	/// Get distance between two dynvecs
 	template< typename T > T distance( const dynvec<T>& v1, const dynvec<T>& v2 )
@@ -117,16 +136,17 @@ namespace xo
 	}
 
 	/// Normalize
-	template< typename T > T normalize( dynvec<T>& v ) { T l = length( v ); if ( l > epsilon<T>() ) { v /= l; } return l; }
+	template< typename T > T normalize( dynvec<T>& v ) { T l = length( v ); if ( l > constants<T>::epsilon() ) { v /= l; } return l; }
 	template< typename T > dynvec<T> normalized( dynvec<T> v ) { normalize( v ); return v; }
 
 	/// Dot product
 	template< typename T > T dot_product( const dynvec<T>& v1, const dynvec<T>& v2 )
 	{
 		xo_assert( v1.size() == v2.size() );
+		const T* a = v1.data(), *b = v2.data();
 		T r = T( 0 );
 		for ( index_t i = 0; i < v1.size(); ++i )
-			r += v1[ i ] * v2[ i ];
+			r += a[ i ] * b[ i ];
 		return r;
 	}
 
@@ -1,9 +1,13 @@
 #pragma once
 
 #include "xo/xo_types.h"
+#include "xo/system/assert.h"
+#include <cmath>
+#include <vector>
 
 namespace xo
 {
+	/// weighted average of values that are added one by one
 	template< typename T >
 	struct average_
 	{
@@ -11,10 +15,14 @@ namespace xo
 		~average_() {}
 
 		void add( T value, T w = T(1) ) { tot_v += w * value; tot_w += w; }
-		T get() { return tot_w > T() ? tot_v / tot_w : T(); }
-		bool empty() { return tot_w == T(); }
+		T get() const { return tot_w > T() ? tot_v / tot_w : T(); }
+		T weight() const { return tot_w; }
+		bool empty() const { return tot_w == T(); }
 		void reset() { tot_v = tot_w = T(); }
 
+		/// combine with an average of other values
+		void merge( const average_& o ) { tot_v += o.tot_v; tot_w += o.tot_w; }
+
 	private:
 		T tot_v;
 		T tot_w;
@@ -22,4 +30,229 @@ namespace xo
 
 	using averagef = average_< float >;
 	using averaged = average_< double >;
+
+	/// weighted mean and variance of values that are added one by one, using the single-pass algorithm of [Welford 1962]
+	/// has the same interface as average_; merge combines partial results as in [Chan et al. 1979]
+	template< typename T >
+	struct mean_variance_
+	{
+		mean_variance_() : w_( T() ), mean_( T() ), m2_( T() ) {}
+
+		void add( T value, T w = T(1) ) {
+			if ( w <= T() ) return;
+			w_ += w;
+			auto delta = value - mean_;
+			mean_ += delta * w / w_;
+			m2_ += w * delta * ( value - mean_ );
+		}
+
+		void merge( const mean_variance_& o ) {
+			if ( o.w_ <= T() ) return;
+			auto w = w_ + o.w_;
+			auto delta = o.mean_ - mean_;
+			mean_ += delta * o.w_ / w;
+			m2_ += o.m2_ + delta * delta * w_ * o.w_ / w;
+			w_ = w;
+		}
+
+		T get() const { return mean_; }
+		T mean() const { return mean_; }
+		T weight() const { return w_; }
+		bool empty() const { return w_ == T(); }
+		void reset() { w_ = mean_ = m2_ = T(); }
+
+		/// population variance
+		T variance() const { return w_ > T() ? m2_ / w_ : T(); }
+		/// sample variance, with Bessel's correction for unit weights
+		T sample_variance() const { return w_ > T(1) ? m2_ / ( w_ - T(1) ) : T(); }
+		T stdev() const { return std::sqrt( variance() ); }
+
+	private:
+		T w_;
+		T mean_;
+		T m2_;
+	};
+
+	using mean_variancef = mean_variance_< float >;
+	using mean_varianced = mean_variance_< double >;
+
+	/// weighted means, variances and covariance of ( x, y ) pairs that are added one by one
+	/// provides single-pass linear regression through linear_regression( const covariance_& ) in regression.h
+	template< typename T >
+	struct covariance_
+	{
+		covariance_() : w_( T() ), mean_x_( T() ), mean_y_( T() ), m2x_( T() ), m2y_( T() ), cxy_( T() ) {}
+
+		void add( T x, T y, T w = T(1) ) {
+			if ( w <= T() ) return;
+			w_ += w;
+			auto dx = x - mean_x_;
+			auto dy = y - mean_y_;
+			mean_x_ += dx * w / w_;
+			mean_y_ += dy * w / w_;
+			m2x_ += w * dx * ( x - mean_x_ );
+			m2y_ += w * dy * ( y - mean_y_ );
+			cxy_ += w * dx * ( y - mean_y_ );
+		}
+
+		void merge( const covariance_& o ) {
+			if ( o.w_ <= T() ) return;
+			auto w = w_ + o.w_;
+			auto dx = o.mean_x_ - mean_x_;
+			auto dy = o.mean_y_ - mean_y_;
+			auto f = w_ * o.w_ / w;
+			mean_x_ += dx * o.w_ / w;
+			mean_y_ += dy * o.w_ / w;
+			m2x_ += o.m2x_ + dx * dx * f;
+			m2y_ += o.m2y_ + dy * dy * f;
+			cxy_ += o.cxy_ + dx * dy * f;
+			w_ = w;
+		}
+
+		T weight() const { return w_; }
+		bool empty() const { return w_ == T(); }
+		void reset() { w_ = mean_x_ = mean_y_ = m2x_ = m2y_ = cxy_ = T(); }
+
+		T mean_x() const { return mean_x_; }
+		T mean_y() const { return mean_y_; }
+		T variance_x() const { return w_ > T() ? m2x_ / w_ : T(); }
+		T variance_y() const { return w_ > T() ? m2y_ / w_ : T(); }
+		T covariance() const { return w_ > T() ? cxy_ / w_ : T(); }
+		T correlation() const { return m2x_ > T() && m2y_ > T() ? cxy_ / std::sqrt( m2x_ * m2y_ ) : T(); }
+
+		/// least-squares slope and offset of y as a function of x
+		T slope() const { return m2x_ > T() ? cxy_ / m2x_ : T(); }
+		T offset() const { return mean_y_ - slope() * mean_x_; }
+
+	private:
+		T w_;
+		T mean_x_;
+		T mean_y_;
+		T m2x_;
+		T m2y_;
+		T cxy_;
+	};
+
+	using covariancef = covariance_< float >;
+	using covarianced = covariance_< double >;
+
+	/// exponentially weighted mean and variance, each new value gets weight alpha relative to the previous values
+	/// merge( o ) assumes the values of o were added after the values of this accumulator
+	template< typename T >
+	struct ewm_variance_
+	{
+		ewm_variance_( T alpha ) : alpha_( alpha ), count_( 0 ), w_( T() ), mean_( T() ), m2_( T() ) {
+			xo_error_if( alpha <= T() || alpha > T(1), "alpha must be in ( 0, 1 ]" );
+		}
+
+		void add( T value ) {
+			decay( T(1) - alpha_ );
+			++count_;
+			// weighted Welford update with weight alpha
+			w_ += alpha_;
+			auto delta = value - mean_;
+			mean_ += delta * alpha_ / w_;
+			m2_ += alpha_ * delta * ( value - mean_ );
+		}
+
+		void merge( const ewm_variance_& o ) {
+			xo_error_if( alpha_ != o.alpha_, "Cannot merge ewm_variance_ with different alpha" );
+			if ( o.count_ == 0 ) return;
+			decay( std::pow( T(1) - alpha_, T( o.count_ ) ) );
+			auto w = w_ + o.w_;
+			auto delta = o.mean_ - mean_;
+			mean_ += delta * o.w_ / w;
+			m2_ += o.m2_ + delta * delta * w_ * o.w_ / w;
+			w_ = w;
+			count_ += o.count_;
+		}
+
+		T get() const { return mean_; }
+		T mean() const { return mean_; }
+		T variance() const { return w_ > T() ? m2_ / w_ : T(); }
+		T stdev() const { return std::sqrt( variance() ); }
+		size_t count() const { return count_; }
+		bool empty() const { return count_ == 0; }
+		void reset() { count_ = 0; w_ = mean_ = m2_ = T(); }
+
+	private:
+		void decay( T f ) { w_ *= f; m2_ *= f; }
+
+		T alpha_;
+		size_t count_;
+		T w_;
+		T mean_;
+		T m2_;
+	};
+
+	using ewm_variancef = ewm_variance_< float >;
+	using ewm_varianced = ewm_variance_< double >;
+
+	/// mean and variance of the last window_size values that were added
+	/// values leaving the window are removed by reversing the Welford update; to limit round-off drift,
+	/// mean and variance are recomputed from the window after every window_size removals.
+	/// sliding windows cannot be merged, because the window of a merged stream spans the chunk boundary.
+	template< typename T >
+	struct sliding_mean_variance_
+	{
+		sliding_mean_variance_( size_t window_size ) : window_( window_size ), next_( 0 ), count_( 0 ), removed_( 0 ), mean_( T() ), m2_( T() ) {
+			xo_error_if( window_size == 0, "Window size must be > 0" );
+		}
+
+		void add( T value ) {
+			if ( count_ == window_.size() ) {
+				auto old = window_[ next_ ];
+				if ( count_ == 1 ) mean_ = m2_ = T();
+				else {
+					auto old_mean = mean_;
+					mean_ = ( T( count_ ) * mean_ - old ) / T( count_ - 1 );
+					m2_ -= ( old - old_mean ) * ( old - mean_ );
+				}
+				--count_;
+				++removed_;
+			}
+			window_[ next_ ] = value;
+			next_ = next_ + 1 == window_.size() ? 0 : next_ + 1;
+			++count_;
+			if ( removed_ >= window_.size() )
+				recompute();
+			else {
+				auto delta = value - mean_;
+				mean_ += delta / T( count_ );
+				m2_ += delta * ( value - mean_ );
+				if ( m2_ < T() ) m2_ = T(); // round-off after removal
+			}
+		}
+
+		T get() const { return mean_; }
+		T mean() const { return mean_; }
+		T variance() const { return count_ > 0 ? m2_ / T( count_ ) : T(); }
+		T sample_variance() const { return count_ > 1 ? m2_ / T( count_ - 1 ) : T(); }
+		T stdev() const { return std::sqrt( variance() ); }
+		size_t size() const { return count_; }
+		size_t window_size() const { return window_.size(); }
+		bool empty() const { return count_ == 0; }
+		void reset() { next_ = count_ = removed_ = 0; mean_ = m2_ = T(); }
+
+	private:
+		// two-pass computation over the full window
+		void recompute() {
+			T sum = T();
+			for ( auto v : window_ ) sum += v;
+			mean_ = sum / T( count_ );
+			m2_ = T();
+			for ( auto v : window_ ) m2_ += ( v - mean_ ) * ( v - mean_ );
+			removed_ = 0;
+		}
+
+		std::vector< T > window_;
+		size_t next_;
+		size_t count_;
+		size_t removed_;
+		T mean_;
+		T m2_;
+	};
+
+	using sliding_mean_variancef = sliding_mean_variance_< float >;
+	using sliding_mean_varianced = sliding_mean_variance_< double >;
 }
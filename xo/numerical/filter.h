@@ -1,8 +1,13 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <complex>
+#include <vector>
 #include "constants.h"
+#include "xo/container/dynarray.h"
+#include "xo/container/small_vector.h"
 
 namespace xo
 {
@@ -48,4 +53,282 @@ namespace xo
 		f.a_[ 1 ] = -( T(1) - q * ita + ita * ita ) * f.b0_;
 		return f;
 	}
+
+	/// iir_filter applied to a number of channels at once, e.g. all channels of a storage frame
+	/// history is stored per delay in structure-of-arrays form, padded and aligned to cache lines, so that
+	/// the loop over channels maps to SIMD lanes. The history rows are used as a ring buffer instead of being
+	/// shifted; the arithmetic is the same as iir_filter, so results are identical per channel.
+	/// Each channel starts with the history of the filter it is constructed from.
+	template< typename T, int N >
+	struct iir_filter_bank
+	{
+		static constexpr size_t lanes = 64 / sizeof( T );
+		static constexpr size_t rows = N + 1;
+
+		iir_filter_bank( const iir_filter< T, N >& f, size_t channels ) :
+			channels_( channels ),
+			stride_( ( channels + lanes - 1 ) / lanes * lanes ),
+			head_( 0 ),
+			b0_( f.b0_ ), b_( f.b_ ), a_( f.a_ ),
+			x_( rows * stride_, T() ),
+			y_( rows * stride_, T() )
+		{
+			// row i holds delay i + 1, which is x_[ i ] and y_[ i ] in iir_filter
+			for ( int i = 0; i < N; ++i ) {
+				std::fill_n( x_.data() + i * stride_, channels_, f.x_[ i ] );
+				std::fill_n( y_.data() + i * stride_, channels_, f.y_[ i ] );
+			}
+		}
+
+		/// filter one frame of channel_size() values, in and out may be the same
+		void operator()( const T* in, T* out ) {
+			// history rows for delays 1 .. N; the new values go into a separate row, so that
+			// the channel loop has no overlapping reads and writes and can be vectorized
+			std::array< const T*, N > xh, yh;
+			for ( int i = 0; i < N; ++i ) {
+				auto row = ( head_ + i ) % rows;
+				xh[ i ] = x_.data() + row * stride_;
+				yh[ i ] = y_.data() + row * stride_;
+			}
+			head_ = ( head_ + rows - 1 ) % rows;
+			T* xn = x_.data() + head_ * stride_;
+			T* yn = y_.data() + head_ * stride_;
+			for ( size_t c = 0; c < channels_; ++c ) {
+				const T x = in[ c ];
+				T y = b0_ * x;
+				for ( int i = 0; i < N; ++i )
+					y += b_[ i ] * xh[ i ][ c ] + a_[ i ] * yh[ i ][ c ];
+				xn[ c ] = x;
+				yn[ c ] = y;
+			}
+			std::copy( yn, yn + channels_, out );
+		}
+
+		/// filter frames of channel_size() values, frames are in_stride and out_stride values apart; in and out may be the same
+		void process( const T* in, T* out, size_t frames, size_t in_stride, size_t out_stride ) {
+			for ( size_t f = 0; f < frames; ++f, in += in_stride, out += out_stride )
+				( *this )( in, out );
+		}
+		void process( const T* in, T* out, size_t frames ) { process( in, out, frames, channels_, channels_ ); }
+
+		/// most recent output of channel c
+		T output( index_t c ) const { return y_[ head_ * stride_ + c ]; }
+
+		size_t channel_size() const { return channels_; }
+		void reset() { x_.assign( T() ); y_.assign( T() ); head_ = 0; }
+
+	private:
+		size_t channels_;
+		size_t stride_;
+		size_t head_;
+		T b0_;
+		std::array< T, N > b_;
+		std::array< T, N > a_;
+		dynarray< T, 64 > x_;
+		dynarray< T, 64 > y_;
+	};
+
+	/// second-order section with transfer function ( b0 + b1 z^-1 + b2 z^-2 ) / ( 1 + a1 z^-1 + a2 z^-2 )
+	/// first-order sections have b2 = a2 = 0. Note that, unlike iir_filter, the a coefficients are not negated.
+	template< typename T >
+	struct biquad
+	{
+		T b0, b1, b2, a1, a2;
+
+		/// gain at frequency 0
+		T dc_gain() const { return ( b0 + b1 + b2 ) / ( T(1) + a1 + a2 ); }
+	};
+
+	/// cascade of second-order sections, created using the functions in filter_design.h
+	/// sections use transposed direct form II, which is numerically robust for high-order filters
+	template< typename T >
+	struct sos_filter
+	{
+		sos_filter() {}
+		template< typename U > explicit sos_filter( const std::vector< biquad< U > >& sections ) :
+			sections_( sections.size() ),
+			state_( 2 * sections.size(), T() )
+		{
+			for ( size_t i = 0; i < sections.size(); ++i ) {
+				const auto& s = sections[ i ];
+				sections_[ i ] = biquad< T >{ T( s.b0 ), T( s.b1 ), T( s.b2 ), T( s.a1 ), T( s.a2 ) };
+			}
+		}
+
+		T operator()( T x ) {
+			T* st = state_.data();
+			for ( const auto& s : sections_ ) {
+				const T y = s.b0 * x + st[ 0 ];
+				st[ 0 ] = s.b1 * x - s.a1 * y + st[ 1 ];
+				st[ 1 ] = s.b2 * x - s.a2 * y;
+				x = y;
+				st += 2;
+			}
+			return x;
+		}
+
+		/// filter n values that are stride values apart, in and out may be the same
+		void process( const T* in, T* out, size_t n, ptrdiff_t in_stride = 1, ptrdiff_t out_stride = 1 ) {
+			for ( size_t i = 0; i < n; ++i, in += in_stride, out += out_stride )
+				*out = ( *this )( *in );
+		}
+
+		/// filter n values forward and then backward, which cancels the phase shift and squares the magnitude response
+		/// edges are extended with a point-reflection of the signal; state is initialized to the steady state of the first
+		/// value of each pass, to minimize transients.
+		void process_zero_phase( T* data, size_t n, ptrdiff_t stride = 1 ) {
+			if ( n == 0 )
+				return;
+			const size_t pad = std::min( 3 * ( 2 * sections_.size() + 1 ), n - 1 );
+			small_vector< T, 64 > left( pad ), right( pad ); // inline for up to 10 sections
+			for ( size_t i = 0; i < pad; ++i ) {
+				left[ i ] = T(2) * data[ 0 ] - data[ ptrdiff_t( pad - i ) * stride ];
+				right[ i ] = T(2) * data[ ptrdiff_t( n - 1 ) * stride ] - data[ ptrdiff_t( n - 2 - i ) * stride ];
+			}
+			reset_steady_state( pad > 0 ? left[ 0 ] : data[ 0 ] );
+			process( left.data(), left.data(), pad );
+			process( data, data, n, stride, stride );
+			process( right.data(), right.data(), pad );
+			reset_steady_state( pad > 0 ? right[ pad - 1 ] : data[ ptrdiff_t( n - 1 ) * stride ] );
+			process( right.data() + pad - 1, right.data() + pad - 1, pad, -1, -1 );
+			T* back = data + ptrdiff_t( n - 1 ) * stride;
+			process( back, back, n, -stride, -stride );
+		}
+
+		/// set the state to the response to a constant input x
+		void reset_steady_state( T x ) {
+			T* st = state_.data();
+			for ( const auto& s : sections_ ) {
+				const T y = s.dc_gain() * x;
+				st[ 0 ] = y - s.b0 * x;
+				st[ 1 ] = s.b2 * x - s.a2 * y;
+				x = y;
+				st += 2;
+			}
+		}
+		void reset() { std::fill( state_.begin(), state_.end(), T() ); }
+
+		/// magnitude of the frequency response at frequency_ratio = frequency / sample rate
+		T magnitude_response( T frequency_ratio ) const {
+			const auto z1 = std::polar( 1.0, -2.0 * constantsd::pi() * double( frequency_ratio ) ); // z^-1
+			std::complex< double > h( 1.0 );
+			for ( const auto& s : sections_ )
+				h *= ( double( s.b0 ) + z1 * ( double( s.b1 ) + z1 * double( s.b2 ) ) ) / ( 1.0 + z1 * ( double( s.a1 ) + z1 * double( s.a2 ) ) );
+			return T( std::abs( h ) );
+		}
+
+		const std::vector< biquad< T > >& sections() const { return sections_; }
+		size_t section_size() const { return sections_.size(); }
+
+		/// internal state, two values per section
+		const std::vector< T >& state() const { return state_; }
+
+	private:
+		std::vector< biquad< T > > sections_;
+		std::vector< T > state_;
+	};
+
+	/// sos_filter applied to a number of channels at once, e.g. all channels of a storage frame
+	/// state is stored per section in structure-of-arrays form, padded and aligned to cache lines, so that
+	/// the loop over channels maps to SIMD lanes. Each frame is processed section by section in a work row,
+	/// using the same arithmetic as sos_filter, so results are identical per channel.
+	/// Each channel starts with the state of the filter it is constructed from.
+	template< typename T >
+	struct sos_filter_bank
+	{
+		static constexpr size_t lanes = 64 / sizeof( T );
+
+		sos_filter_bank( const sos_filter< T >& f, size_t channels ) :
+			channels_( channels ),
+			stride_( ( channels + lanes - 1 ) / lanes * lanes ),
+			sections_( f.sections() ),
+			state_( 2 * sections_.size() * stride_, T() ),
+			work_( stride_, T() )
+		{
+			for ( size_t i = 0; i < f.state().size(); ++i )
+				std::fill_n( state_.data() + i * stride_, channels_, f.state()[ i ] );
+		}
+
+		/// filter one frame of channel_size() values, in and out may be the same
+		void operator()( const T* in, T* out ) {
+			T* w = work_.data();
+			std::copy( in, in + channels_, w );
+			T* s1 = state_.data();
+			for ( const auto& s : sections_ ) {
+				T* s2 = s1 + stride_;
+				const T b0 = s.b0, b1 = s.b1, b2 = s.b2, a1 = s.a1, a2 = s.a2;
+				for ( size_t c = 0; c < channels_; ++c ) {
+					const T x = w[ c ];
+					const T y = b0 * x + s1[ c ];
+					s1[ c ] = b1 * x - a1 * y + s2[ c ];
+					s2[ c ] = b2 * x - a2 * y;
+					w[ c ] = y;
+				}
+				s1 = s2 + stride_;
+			}
+			std::copy( w, w + channels_, out );
+		}
+
+		/// filter frames of channel_size() values, frames are in_stride and out_stride values apart; in and out may be the same
+		void process( const T* in, T* out, size_t frames, ptrdiff_t in_stride, ptrdiff_t out_stride ) {
+			for ( size_t f = 0; f < frames; ++f, in += in_stride, out += out_stride )
+				( *this )( in, out );
+		}
+		void process( const T* in, T* out, size_t frames ) { process( in, out, frames, ptrdiff_t( channels_ ), ptrdiff_t( channels_ ) ); }
+
+		/// filter frames forward and then backward in-place, see sos_filter::process_zero_phase()
+		void process_zero_phase( T* data, size_t frames, ptrdiff_t stride ) {
+			if ( frames == 0 )
+				return;
+			const ptrdiff_t nc = channels_;
+			const size_t pad = std::min( 3 * ( 2 * sections_.size() + 1 ), frames - 1 );
+			const T* first = data;
+			T* last = data + ptrdiff_t( frames - 1 ) * stride;
+			std::vector< T > left( pad * channels_ ), right( pad * channels_ );
+			for ( size_t i = 0; i < pad; ++i ) {
+				const T* lsrc = data + ptrdiff_t( pad - i ) * stride;
+				const T* rsrc = data + ptrdiff_t( frames - 2 - i ) * stride;
+				for ( size_t c = 0; c < channels_; ++c ) {
+					left[ i * channels_ + c ] = T(2) * first[ c ] - lsrc[ c ];
+					right[ i * channels_ + c ] = T(2) * last[ c ] - rsrc[ c ];
+				}
+			}
+			reset_steady_state( pad > 0 ? left.data() : first );
+			process( left.data(), left.data(), pad );
+			process( data, data, frames, stride, stride );
+			process( right.data(), right.data(), pad );
+			T* right_last = right.data() + ( pad > 0 ? ( pad - 1 ) * channels_ : 0 );
+			reset_steady_state( pad > 0 ? right_last : last );
+			process( right_last, right_last, pad, -nc, -nc );
+			process( last, last, frames, -stride, -stride );
+		}
+
+		/// set the state of each channel to the response to a constant input x[ c ]
+		void reset_steady_state( const T* x ) {
+			T* w = work_.data();
+			std::copy( x, x + channels_, w );
+			T* s1 = state_.data();
+			for ( const auto& s : sections_ ) {
+				T* s2 = s1 + stride_;
+				const T g = s.dc_gain();
+				for ( size_t c = 0; c < channels_; ++c ) {
+					const T y = g * w[ c ];
+					s1[ c ] = y - s.b0 * w[ c ];
+					s2[ c ] = s.b2 * w[ c ] - s.a2 * y;
+					w[ c ] = y;
+				}
+				s1 = s2 + stride_;
+			}
+		}
+
+		size_t channel_size() const { return channels_; }
+		void reset() { state_.assign( T() ); }
+
+	private:
+		size_t channels_;
+		size_t stride_;
+		std::vector< biquad< T > > sections_;
+		dynarray< T, 64 > state_;
+		dynarray< T, 64 > work_;
+	};
 }
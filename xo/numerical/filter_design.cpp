@@ -0,0 +1,227 @@
+#include "filter_design.h"
+
+#include "xo/system/assert.h"
+#include "xo/string/string_cast.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+namespace xo
+{
+	namespace
+	{
+		using complexd = std::complex< double >;
+
+		// poles of a normalized analog lowpass prototype, with gain to be applied at the reference frequency
+		struct prototype
+		{
+			std::vector< complexd > poles;
+			double gain = 1.0;
+		};
+
+		prototype butterworth_prototype( int n ) {
+			prototype pt;
+			for ( int k = 0; k < n; ++k )
+				pt.poles.push_back( std::polar( 1.0, constantsd::pi() * ( 2 * k + n + 1 ) / ( 2 * n ) ) );
+			return pt;
+		}
+
+		prototype chebyshev_prototype( int n, double ripple_db ) {
+			prototype pt;
+			const double eps = std::sqrt( std::pow( 10.0, ripple_db / 10.0 ) - 1.0 );
+			const double mu = std::asinh( 1.0 / eps ) / n;
+			for ( int k = 0; k < n; ++k ) {
+				const double theta = constantsd::pi() * ( 2 * k + 1 ) / ( 2 * n );
+				pt.poles.emplace_back( -std::sinh( mu ) * std::sin( theta ), std::cosh( mu ) * std::cos( theta ) );
+			}
+			if ( n % 2 == 0 )
+				pt.gain = 1.0 / std::sqrt( 1.0 + eps * eps ); // even orders start at the bottom of the ripple band
+			return pt;
+		}
+
+		prototype bessel_prototype( int n ) {
+			// roots of the reverse Bessel polynomial, with a_0 = (2n)! / ( 2^n n! ) and a_n = 1
+			double a0 = 1.0;
+			for ( int k = n + 1; k <= 2 * n; ++k )
+				a0 *= 0.5 * k;
+
+			// p / p' at s, evaluated using the recurrence theta_k = ( 2k - 1 ) theta_k-1 + s^2 theta_k-2,
+			// which is more accurate near the roots than the expanded polynomial
+			auto newton_step = [n]( complexd s ) {
+				complexd p0 = 1.0, p1 = s + 1.0, d0 = 0.0, d1 = 1.0;
+				for ( int k = 2; k <= n; ++k ) {
+					const complexd p2 = double( 2 * k - 1 ) * p1 + s * s * p0;
+					const complexd d2 = double( 2 * k - 1 ) * d1 + 2.0 * s * p0 + s * s * d0;
+					p0 = p1; p1 = p2; d0 = d1; d1 = d2;
+				}
+				return p1 / d1;
+			};
+
+			// Aberth iteration, starting on a rotated circle with the radius of the roots
+			const double g = std::pow( a0, 1.0 / n );
+			std::vector< complexd > r( n );
+			for ( int i = 0; i < n; ++i )
+				r[ i ] = std::polar( g, constantsd::pi() * ( 2 * i + n + 1 ) / ( 2 * n ) + 0.1 );
+			for ( int iteration = 0; iteration < 200; ++iteration ) {
+				double max_delta = 0.0;
+				for ( int i = 0; i < n; ++i ) {
+					const auto ratio = newton_step( r[ i ] );
+					complexd sum = 0.0;
+					for ( int j = 0; j < n; ++j )
+						if ( j != i )
+							sum += 1.0 / ( r[ i ] - r[ j ] );
+					const auto delta = ratio / ( 1.0 - ratio * sum );
+					r[ i ] -= delta;
+					max_delta = std::max( max_delta, std::abs( delta ) / g );
+				}
+				if ( max_delta < 1e-14 )
+					break;
+			}
+
+			// make roots exact conjugate pairs, with a single real root for odd orders
+			std::sort( r.begin(), r.end(), []( const complexd& a, const complexd& b ) { return a.imag() < b.imag(); } );
+			for ( int i = 0; i < n / 2; ++i ) {
+				r[ i ] = 0.5 * ( r[ i ] + std::conj( r[ n - 1 - i ] ) );
+				r[ n - 1 - i ] = std::conj( r[ i ] );
+			}
+			if ( n % 2 == 1 )
+				r[ n / 2 ] = r[ n / 2 ].real();
+
+			// scale so that the magnitude is -3dB at 1, found through bisection
+			prototype pt;
+			pt.poles = r;
+			auto mag2 = [&]( double w ) {
+				double m = 1.0;
+				for ( auto& p : pt.poles )
+					m *= std::norm( p ) / std::norm( complexd( 0.0, w ) - p );
+				return m;
+			};
+			double lo = 0.0, hi = 1.0;
+			while ( mag2( hi ) > 0.5 )
+				hi *= 2.0;
+			for ( int i = 0; i < 100; ++i )
+				( mag2( 0.5 * ( lo + hi ) ) > 0.5 ? lo : hi ) = 0.5 * ( lo + hi );
+			for ( auto& p : pt.poles )
+				p /= 0.5 * ( lo + hi );
+			return pt;
+		}
+
+		double prewarp( double f ) { return 2.0 * std::tan( constantsd::pi() * f ); }
+
+		// digital transfer function of a section at frequency f
+		complexd response( const biquad< double >& s, double f ) {
+			const auto z1 = std::polar( 1.0, -2.0 * constantsd::pi() * f );
+			return ( s.b0 + z1 * ( s.b1 + z1 * s.b2 ) ) / ( 1.0 + z1 * ( s.a1 + z1 * s.a2 ) );
+		}
+
+		std::vector< biquad< double > > design( const prototype& pt, filter_pass pass, double cutoff, double cutoff_high ) {
+			xo_error_if( cutoff <= 0.0 || cutoff >= 0.5, "Cutoff frequency ratio must be in ( 0, 0.5 )" );
+			xo_error_if( pass == filter_pass::bandpass && ( cutoff_high <= cutoff || cutoff_high >= 0.5 ), "Upper cutoff frequency ratio must be in ( cutoff, 0.5 )" );
+
+			// transform prototype to analog poles and digital zeros
+			std::vector< complexd > poles;
+			std::vector< double > zeros;
+			const auto n = pt.poles.size();
+			const double w = prewarp( cutoff );
+			double f_ref = 0.0;
+			switch ( pass )
+			{
+			case filter_pass::lowpass:
+				for ( auto& p : pt.poles )
+					poles.push_back( w * p );
+				zeros.assign( n, -1.0 );
+				break;
+			case filter_pass::highpass:
+				for ( auto& p : pt.poles )
+					poles.push_back( w / p );
+				zeros.assign( n, 1.0 );
+				f_ref = 0.5;
+				break;
+			case filter_pass::bandpass:
+			{
+				const double wh = prewarp( cutoff_high );
+				const double w0 = std::sqrt( w * wh ), bw = wh - w;
+				for ( auto& p : pt.poles ) {
+					const auto a = 0.5 * bw * p;
+					const auto d = std::sqrt( a * a - w0 * w0 );
+					poles.push_back( a + d );
+					poles.push_back( a - d );
+				}
+				zeros.assign( n, -1.0 );
+				zeros.insert( zeros.end(), n, 1.0 );
+				f_ref = std::atan( 0.5 * w0 ) / constantsd::pi();
+				break;
+			}
+			}
+
+			// bilinear transform and grouping into sections of conjugate pairs or two real poles
+			std::vector< complexd > pairs;
+			std::vector< double > reals;
+			for ( auto& p : poles ) {
+				const auto pd = ( 2.0 + p ) / ( 2.0 - p );
+				if ( std::abs( pd.imag() ) <= 1e-10 * std::abs( pd ) )
+					reals.push_back( pd.real() );
+				else if ( pd.imag() > 0.0 )
+					pairs.push_back( pd );
+			}
+			xo_error_if( 2 * pairs.size() + reals.size() != poles.size(), "Could not find pole pairs" );
+
+			// sections with poles furthest from the unit circle come first, to reduce internal gain
+			struct section_poles { double a1, a2, radius; bool second_order; };
+			std::vector< section_poles > sp;
+			for ( auto& p : pairs )
+				sp.push_back( { -2.0 * p.real(), std::norm( p ), std::abs( p ), true } );
+			std::sort( reals.begin(), reals.end() );
+			for ( size_t i = 0; i < reals.size(); i += 2 ) {
+				if ( i + 1 < reals.size() )
+					sp.push_back( { -( reals[ i ] + reals[ i + 1 ] ), reals[ i ] * reals[ i + 1 ], std::max( std::abs( reals[ i ] ), std::abs( reals[ i + 1 ] ) ), true } );
+				else sp.push_back( { -reals[ i ], 0.0, std::abs( reals[ i ] ), false } );
+			}
+			std::stable_sort( sp.begin(), sp.end(), []( const section_poles& a, const section_poles& b ) { return a.radius < b.radius; } );
+
+			// each section gets the lowest and highest remaining zero, so band-pass sections get one zero at -1 and one at +1
+			std::vector< biquad< double > > sections;
+			size_t zlo = 0, zhi = zeros.size();
+			for ( auto& s : sp ) {
+				if ( s.second_order ) {
+					const double z1 = zeros[ zlo++ ], z2 = zeros[ --zhi ];
+					sections.push_back( { 1.0, -( z1 + z2 ), z1 * z2, s.a1, s.a2 } );
+				}
+				else sections.push_back( { 1.0, -zeros[ zlo++ ], 0.0, s.a1, 0.0 } );
+			}
+
+			// normalize gain at the reference frequency
+			complexd h = 1.0;
+			for ( auto& s : sections )
+				h *= response( s, f_ref );
+			const double g = pt.gain / std::abs( h );
+			sections.front().b0 *= g;
+			sections.front().b1 *= g;
+			sections.front().b2 *= g;
+			return sections;
+		}
+
+		void check_order( int order, int max_order = 32 ) {
+			xo_error_if( order < 1 || order > max_order, "Filter order must be between 1 and " + to_str( max_order ) );
+		}
+	}
+
+	std::vector< biquad< double > > design_butterworth( int order, filter_pass pass, double cutoff, double cutoff_high )
+	{
+		check_order( order );
+		return design( butterworth_prototype( order ), pass, cutoff, cutoff_high );
+	}
+
+	std::vector< biquad< double > > design_bessel( int order, filter_pass pass, double cutoff, double cutoff_high )
+	{
+		check_order( order, 24 ); // higher orders cannot be computed accurately in double precision
+		return design( bessel_prototype( order ), pass, cutoff, cutoff_high );
+	}
+
+	std::vector< biquad< double > > design_chebyshev( int order, double ripple_db, filter_pass pass, double cutoff, double cutoff_high )
+	{
+		check_order( order );
+		xo_error_if( ripple_db <= 0.0, "Ripple must be > 0 dB" );
+		return design( chebyshev_prototype( order, ripple_db ), pass, cutoff, cutoff_high );
+	}
+}
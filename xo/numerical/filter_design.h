@@ -0,0 +1,28 @@
+#pragma once
+
+#include "xo/system/xo_config.h"
+#include "filter.h"
+#include <vector>
+
+namespace xo
+{
+	enum class filter_pass { lowpass, highpass, bandpass };
+
+	/// design filters as cascades of second-order sections, using an analog prototype and the bilinear transform
+	/// frequencies are specified as ratio of the sample rate and must be in ( 0, 0.5 ); cutoff is the -3dB frequency
+	/// for butterworth and bessel filters, and the edge of the ripple band for chebyshev filters. Band-pass filters
+	/// use cutoff as lower and cutoff_high as upper frequency, and have twice the specified order. The order must be
+	/// between 1 and 32, or between 1 and 24 for bessel filters, whose poles lose accuracy at higher orders.
+	XO_API std::vector< biquad< double > > design_butterworth( int order, filter_pass pass, double cutoff, double cutoff_high = 0.0 );
+	XO_API std::vector< biquad< double > > design_bessel( int order, filter_pass pass, double cutoff, double cutoff_high = 0.0 );
+	XO_API std::vector< biquad< double > > design_chebyshev( int order, double ripple_db, filter_pass pass, double cutoff, double cutoff_high = 0.0 );
+
+	template< typename T > sos_filter< T > make_butterworth_filter( int order, filter_pass pass, double cutoff, double cutoff_high = 0.0 )
+	{ return sos_filter< T >( design_butterworth( order, pass, cutoff, cutoff_high ) ); }
+
+	template< typename T > sos_filter< T > make_bessel_filter( int order, filter_pass pass, double cutoff, double cutoff_high = 0.0 )
+	{ return sos_filter< T >( design_bessel( order, pass, cutoff, cutoff_high ) ); }
+
+	template< typename T > sos_filter< T > make_chebyshev_filter( int order, double ripple_db, filter_pass pass, double cutoff, double cutoff_high = 0.0 )
+	{ return sos_filter< T >( design_chebyshev( order, ripple_db, pass, cutoff, cutoff_high ) ); }
+}
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "xo/xo_types.h"
+#include "xo/system/assert.h"
 #include <cmath>
+#include <limits>
 
 namespace xo
 {
@@ -49,6 +51,12 @@ namespace xo
 	/// check if an integer value is a power of two
 	template< typename T > bool is_power_of_two( T v ) { return v != 0 && !( v & ( v - 1 ) ); }
 
+	/// smallest power of two that is not smaller than integer value v, throws if it does not fit in T
+	template< typename T > constexpr T ceil_power_of_two( T v ) {
+		xo_error_if( v > ( std::numeric_limits< T >::max() >> 1 ) + 1, "ceil_power_of_two overflow" );
+		T p = 1; while ( p < v ) p <<= 1; return p;
+	}
+
 	/// check if an integer value is odd / even
 	template< typename T > bool is_even( T v ) { return ( v & 1 ) == 0; }
 	template< typename T > bool is_odd( T v ) { return ( v & 1 ) == 1; }
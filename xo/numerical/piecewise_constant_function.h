@@ -14,6 +14,9 @@ namespace xo
 
 		void insert_point( T x, T y ) { data_[ x ] = y; }
 
+		/// insert range of ( x, y ) pairs, which are sorted and merged in a single pass
+		template< typename It > void insert_points( It first, It last ) { data_.insert( first, last ); }
+
 		T operator()( const T& x ) const
 		{
 			xo_assert( !data_.empty() );
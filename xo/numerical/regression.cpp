@@ -0,0 +1,232 @@
+#include "regression.h"
+
+#include "xo/numerical/random.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace xo
+{
+	namespace
+	{
+		// evaluates, for all points, how many slopes to the other points are <= theta
+		// for points p < q (with x_p < x_q), slope_pq <= theta <=> y_q - theta x_q <= y_p - theta x_p
+		struct slope_counter
+		{
+			slope_counter( const std::vector< double >& x, const std::vector< double >& y ) :
+				x_( x ), y_( y ), n_( x.size() ), u_( n_ ), order_( n_ ), rank_( n_ ), tree_( n_ + 1 ) {}
+
+			void count( double theta, std::vector< size_t >& c ) {
+				for ( size_t p = 0; p < n_; ++p )
+					u_[ p ] = y_[ p ] - theta * x_[ p ];
+
+				// dense ranks of u, equal values get equal ranks
+				for ( size_t p = 0; p < n_; ++p )
+					order_[ p ] = p;
+				std::sort( order_.begin(), order_.end(), [&]( size_t a, size_t b ) { return u_[ a ] < u_[ b ]; } );
+				size_t r = 1;
+				for ( size_t i = 0; i < n_; ++i ) {
+					if ( i > 0 && u_[ order_[ i ] ] != u_[ order_[ i - 1 ] ] )
+						++r;
+					rank_[ order_[ i ] ] = r;
+				}
+
+				// points on the left with u >= u_p
+				std::fill( tree_.begin(), tree_.end(), size_t( 0 ) );
+				for ( size_t p = 0; p < n_; ++p ) {
+					c[ p ] = p - prefix_sum( rank_[ p ] - 1 );
+					add( rank_[ p ] );
+				}
+
+				// points on the right with u <= u_p
+				std::fill( tree_.begin(), tree_.end(), size_t( 0 ) );
+				for ( size_t p = n_; p-- > 0; ) {
+					c[ p ] += prefix_sum( rank_[ p ] );
+					add( rank_[ p ] );
+				}
+			}
+
+		private:
+			void add( size_t r ) { for ( ; r <= n_; r += r & ( ~r + 1 ) ) ++tree_[ r ]; }
+			size_t prefix_sum( size_t r ) const { size_t s = 0; for ( ; r > 0; r -= r & ( ~r + 1 ) ) s += tree_[ r ]; return s; }
+
+			const std::vector< double >& x_;
+			const std::vector< double >& y_;
+			size_t n_;
+			std::vector< double > u_;
+			std::vector< size_t > order_;
+			std::vector< size_t > rank_;
+			std::vector< size_t > tree_;
+		};
+
+		// call f( p, q ) for all pairs p, q that come in order p, q when sorted by a, but not when sorted by b
+		// done using a merge sort on b, in O( n log n + number of pairs ); returns false if there are more than max_pairs
+		template< typename F > bool for_each_inversion( const std::vector< double >& a, const std::vector< double >& b, size_t max_pairs, F f ) {
+			const auto n = a.size();
+			std::vector< size_t > seq( n ), tmp( n );
+			for ( size_t i = 0; i < n; ++i )
+				seq[ i ] = i;
+			std::sort( seq.begin(), seq.end(), [&]( size_t i, size_t j ) { return a[ i ] < a[ j ] || ( a[ i ] == a[ j ] && b[ i ] < b[ j ] ); } );
+			size_t pairs = 0;
+			for ( size_t width = 1; width < n; width *= 2 ) {
+				for ( size_t lb = 0; lb < n; lb += 2 * width ) {
+					const size_t le = std::min( lb + width, n ), re = std::min( lb + 2 * width, n );
+					size_t i = lb, j = le, o = lb;
+					while ( i < le && j < re ) {
+						if ( b[ seq[ i ] ] < b[ seq[ j ] ] )
+							tmp[ o++ ] = seq[ i++ ];
+						else {
+							pairs += le - i;
+							if ( pairs > max_pairs )
+								return false;
+							for ( size_t k = i; k < le; ++k )
+								f( seq[ k ], seq[ j ] );
+							tmp[ o++ ] = seq[ j++ ];
+						}
+					}
+					while ( i < le ) tmp[ o++ ] = seq[ i++ ];
+					while ( j < re ) tmp[ o++ ] = seq[ j++ ];
+				}
+				seq.swap( tmp );
+			}
+			return true;
+		}
+
+		// exact O( n^2 ) fallback for degenerate inputs
+		double low_repeated_median_slope_exact( const std::vector< double >& x, const std::vector< double >& y ) {
+			const auto n = x.size();
+			std::vector< double > sl( n - 1 ), med( n );
+			for ( size_t i = 0; i < n; ++i ) {
+				auto it = sl.begin();
+				for ( size_t j = 0; j < n; ++j )
+					if ( j != i )
+						*it++ = ( y[ j ] - y[ i ] ) / ( x[ j ] - x[ i ] );
+				select_nth( sl.begin(), sl.begin() + ( n - 2 ) / 2, sl.end() );
+				med[ i ] = sl[ ( n - 2 ) / 2 ];
+			}
+			select_nth( med.begin(), med.begin() + ( n - 1 ) / 2, med.end() );
+			return med[ ( n - 1 ) / 2 ];
+		}
+	}
+
+	double fast_repeated_median_slope( const std::vector< double >& x, const std::vector< double >& y, unsigned int seed )
+	{
+		const size_t n = x.size();
+		xo_error_if( n < 2 || y.size() != n, "Input must contain at least 2 points" );
+		if ( n < 64 || std::adjacent_find( x.begin(), x.end() ) != x.end() )
+			return low_repeated_median_slope_exact( x, y ); // small or degenerate input
+		const size_t k = ( n - 2 ) / 2; // rank of the low median of the n - 1 slopes per point
+		const size_t K = ( n - 1 ) / 2; // rank of the low median of the n per-point medians
+		const double inf = std::numeric_limits< double >::infinity();
+		const size_t max_pairs = 8 * n;
+
+		// the repeated median is in ( lo, hi ], clo and chi contain the number of slopes <= lo and <= hi for each point
+		double lo = -inf, hi = inf;
+		std::vector< size_t > clo( n, 0 ), chi( n, n - 1 ), c( n );
+		std::vector< size_t > active;
+		std::vector< double > hits;
+		slope_counter counter( x, y );
+		random_number_generator rng( seed );
+		size_t below = 0;
+
+		auto slope = [&]( size_t i, size_t j ) { return ( y[ j ] - y[ i ] ) / ( x[ j ] - x[ i ] ); };
+		auto update_active = [&]() {
+			active.clear();
+			below = 0;
+			for ( size_t i = 0; i < n; ++i ) {
+				if ( clo[ i ] > k ) ++below;
+				else if ( chi[ i ] > k ) active.push_back( i );
+			}
+		};
+		auto pairs_in_interval = [&]() {
+			size_t s = 0;
+			for ( size_t i = 0; i < n; ++i )
+				s += chi[ i ] - clo[ i ];
+			return s / 2;
+		};
+
+		update_active();
+		for ( int iteration = 0; pairs_in_interval() > max_pairs && iteration < 256; ++iteration ) {
+			if ( active.empty() || below > K )
+				return low_repeated_median_slope_exact( x, y ); // counts are inconsistent due to round-off
+
+			// split the interval at the median of a random sample of its slopes
+			hits.clear();
+			for ( size_t s = 0; s < 4 * n && hits.size() < 1024; ++s ) {
+				auto i = active[ rng.uni< size_t >( 0, active.size() - 1 ) ];
+				auto j = rng.uni< size_t >( 0, n - 1 );
+				if ( i != j )
+					if ( auto sl = slope( i, j ); sl > lo && sl <= hi )
+						hits.push_back( sl );
+			}
+			if ( hits.empty() ) {
+				for ( size_t j = 0; j < n; ++j )
+					if ( auto sl = slope( active.front(), j ); j != active.front() && sl > lo && sl <= hi )
+						hits.push_back( sl );
+				if ( hits.empty() )
+					return low_repeated_median_slope_exact( x, y );
+			}
+			auto mid = hits.begin() + hits.size() / 2;
+			select_nth( hits.begin(), mid, hits.end() );
+			auto theta = *mid;
+			if ( theta >= hi ) {
+				theta = std::nextafter( hi, -inf );
+				if ( theta <= lo )
+					return hi; // hi is the only value in the interval
+			}
+
+			counter.count( theta, c );
+			size_t num_le = 0;
+			for ( auto ci : c )
+				num_le += size_t( ci > k );
+			if ( num_le > K ) { hi = theta; chi.swap( c ); }
+			else { lo = theta; clo.swap( c ); }
+			update_active();
+		}
+		if ( active.empty() || below > K )
+			return low_repeated_median_slope_exact( x, y );
+
+		// enumerate the remaining slopes in the interval, which change order between lo and hi
+		std::vector< double > a( n ), b( n );
+		for ( size_t p = 0; p < n; ++p ) {
+			a[ p ] = std::isfinite( lo ) ? y[ p ] - lo * x[ p ] : x[ p ];
+			b[ p ] = std::isfinite( hi ) ? y[ p ] - hi * x[ p ] : -x[ p ];
+		}
+		std::vector< size_t > active_idx( n, no_index ), offsets( active.size() + 1, 0 );
+		for ( size_t i = 0; i < active.size(); ++i )
+			active_idx[ active[ i ] ] = i;
+		std::vector< std::pair< size_t, size_t > > pairs;
+		pairs.reserve( max_pairs );
+		if ( !for_each_inversion( a, b, 2 * max_pairs, [&]( size_t p, size_t q ) { pairs.emplace_back( p, q ); } ) )
+			return low_repeated_median_slope_exact( x, y );
+
+		// gather slopes per active point
+		for ( auto [p, q] : pairs ) {
+			if ( active_idx[ p ] != no_index ) ++offsets[ active_idx[ p ] + 1 ];
+			if ( active_idx[ q ] != no_index ) ++offsets[ active_idx[ q ] + 1 ];
+		}
+		for ( size_t i = 0; i < active.size(); ++i )
+			offsets[ i + 1 ] += offsets[ i ];
+		std::vector< double > slopes( offsets.back() );
+		std::vector< size_t > fill( offsets.begin(), offsets.end() - 1 );
+		for ( auto [p, q] : pairs ) {
+			auto s = slope( p, q );
+			if ( active_idx[ p ] != no_index ) slopes[ fill[ active_idx[ p ] ]++ ] = s;
+			if ( active_idx[ q ] != no_index ) slopes[ fill[ active_idx[ q ] ]++ ] = s;
+		}
+
+		// median per active point, then the median of those
+		std::vector< double > medians( active.size() );
+		for ( size_t i = 0; i < active.size(); ++i ) {
+			auto sb = slopes.begin() + offsets[ i ], se = slopes.begin() + offsets[ i + 1 ];
+			if ( sb == se )
+				return low_repeated_median_slope_exact( x, y );
+			auto r = std::min( k - clo[ active[ i ] ], size_t( se - sb - 1 ) );
+			select_nth( sb, sb + r, se );
+			medians[ i ] = sb[ r ];
+		}
+		auto r = std::min( K - below, medians.size() - 1 );
+		select_nth( medians.begin(), medians.begin() + r, medians.end() );
+		return medians[ r ];
+	}
+}
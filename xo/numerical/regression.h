@@ -3,8 +3,10 @@
 #include <numeric>
 
 #include "math.h"
+#include "average.h"
 #include "polynomial.h"
 #include "xo/container/container_algorithms.h"
+#include "xo/thread/thread_pool.h"
 
 namespace xo
 {
@@ -50,6 +52,11 @@ namespace xo
 	auto linear_regression( const C1& cx, const C2& cy )
 	{ return linear_regression( std::begin( cx ), std::end( cx ), std::begin( cy ), std::end( cy ) ); }
 
+	/// linear regression from a single-pass accumulator, which can be updated with new samples or merged
+	template< typename T >
+	linear_function< T > linear_regression( const covariance_< T >& acc )
+	{ return linear_function< T >( acc.offset(), acc.slope() ); }
+
 	template< typename CY >
 	linear_function< typename CY::value_type > linear_median_regression( const CY& cy, typename CY::value_type x_begin, typename CY::value_type x_step )
 	{
@@ -59,7 +66,7 @@ namespace xo
 		slopes.reserve( cy.size() );
 		for ( index_t i = 0; i < cy.size() - 1; ++i )
 			slopes.push_back( cy[ i + 1 ] - cy[ i ] );
-		auto medslope = median( slopes ) / x_step;
+		auto medslope = median_non_const( slopes ) / x_step;
 		auto medy = median( cy );
 		auto medx = x_begin + x_step * ( cy.size() - 1 ) / 2;
 		return linear_function< T >( medy - medslope * medx, medslope );
@@ -73,22 +80,82 @@ namespace xo
 		auto n = xe - xb;
 		xo_assert_msg( n > 1 && n == ye - yb, "Input ranges must be > 1 and of equal size for x and y" );
 
-		std::vector< T > sl1, sl2;
-		sl1.reserve( n - 1 );
-		sl2.reserve( n - 1 );
-
+		std::vector< T > sl1( n - 1 ), sl2( n );
 		for ( int i = 0; i < n; ++i )
 		{
-			sl1.clear();
-			sl1.reserve( n - 1 );
-			for ( int j = 0; j < i; ++j )
-				sl1.emplace_back( ( *( yb + j ) - *( yb + i ) ) / ( *( xb + j ) - *( xb + i ) ) );
-			for ( int j = i + 1; j < n; ++j )
-				sl1.emplace_back( ( *( yb + j ) - *( yb + i ) ) / ( *( xb + j ) - *( xb + i ) ) );
-			sl2.emplace_back( median_non_const( sl1 ) );
+			auto xi = *( xb + i );
+			auto yi = *( yb + i );
+			auto it = sl1.begin();
+			for ( int j = 0; j < n; ++j )
+				if ( j != i )
+					*it++ = ( *( yb + j ) - yi ) / ( *( xb + j ) - xi );
+			sl2[ i ] = median_non_const( sl1 );
 		}
 		auto slope = median_non_const( sl2 );
 
+		// reuse sl2 for the intercepts
+		for ( int i = 0; i < n; ++i )
+			sl2[ i ] = *( yb + i ) - slope * *( xb + i );
+		auto offset = median_non_const( sl2 );
+
+		return linear_function< T >( offset, slope );
+	}
+
+	/// repeated median regression using the exact algorithm of [Siegel 1982], with the per-point medians computed in parallel
+	template< typename ItX, typename ItY >
+	linear_function< typename std::remove_const< typename std::iterator_traits< ItY >::value_type >::type > repeated_median_regression_parallel( ItX xb, ItX xe, ItY yb, ItY ye, thread_pool& pool = global_thread_pool() )
+	{
+		using T = typename std::remove_const< typename std::iterator_traits< ItY >::value_type >::type;
+		auto n = xe - xb;
+		xo_assert_msg( n > 1 && n == ye - yb, "Input ranges must be > 1 and of equal size for x and y" );
+
+		std::vector< T > sl2( n );
+		pool.parallel_for( 0, size_t( n ), [&]( size_t b, size_t e ) {
+			std::vector< T > sl1( n - 1 );
+			for ( auto i = b; i < e; ++i )
+			{
+				auto xi = *( xb + i );
+				auto yi = *( yb + i );
+				auto it = sl1.begin();
+				for ( size_t j = 0; j < size_t( n ); ++j )
+					if ( j != i )
+						*it++ = ( *( yb + j ) - yi ) / ( *( xb + j ) - xi );
+				sl2[ i ] = median_non_const( sl1 );
+			}
+		}, 16 );
+		auto slope = median_non_const( sl2 );
+
+		for ( int i = 0; i < n; ++i )
+			sl2[ i ] = *( yb + i ) - slope * *( xb + i );
+		auto offset = median_non_const( sl2 );
+
+		return linear_function< T >( offset, slope );
+	}
+
+	/// low repeated median slope of points sorted by x, in expected O( n log^2 n ) time
+	/// small inputs and inputs with duplicate x values use the exact O( n^2 ) algorithm, which gives the same result
+	XO_API double fast_repeated_median_slope( const std::vector< double >& x, const std::vector< double >& y, unsigned int seed = 123 );
+
+	/// repeated median regression in expected O( n log^2 n ) time, using randomized interval contraction as in [Matousek et al. 1998]
+	/// slope medians of an even number of values use the lower of the two middle values for any input size,
+	/// so results may differ slightly from repeated_median_regression
+	template< typename ItX, typename ItY >
+	linear_function< typename std::remove_const< typename std::iterator_traits< ItY >::value_type >::type > fast_repeated_median_regression( ItX xb, ItX xe, ItY yb, ItY ye )
+	{
+		using T = typename std::remove_const< typename std::iterator_traits< ItY >::value_type >::type;
+		auto n = xe - xb;
+		xo_assert_msg( n > 1 && n == ye - yb, "Input ranges must be > 1 and of equal size for x and y" );
+
+		std::vector< size_t > order( n );
+		for ( size_t i = 0; i < order.size(); ++i )
+			order[ i ] = i;
+		std::sort( order.begin(), order.end(), [&]( size_t a, size_t b ) { return *( xb + a ) < *( xb + b ); } );
+		std::vector< double > x( n ), y( n );
+		for ( size_t i = 0; i < order.size(); ++i ) {
+			x[ i ] = double( *( xb + order[ i ] ) );
+			y[ i ] = double( *( yb + order[ i ] ) );
+		}
+		auto slope = T( fast_repeated_median_slope( x, y ) );
 		std::vector< T > intercepts( n );
 		for ( int i = 0; i < n; ++i )
 			intercepts[ i ] = *( yb + i ) - slope * *( xb + i );
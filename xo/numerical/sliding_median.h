@@ -0,0 +1,64 @@
+#pragma once
+
+#include "xo/xo_types.h"
+#include "xo/system/assert.h"
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace xo
+{
+	/// median of the last window_size values that were added
+	/// values are kept in a sorted array next to a ring buffer in insertion order; each update
+	/// is a binary search plus a contiguous move, which for typical window sizes is faster than
+	/// heap- or tree-based approaches and does not allocate after construction.
+	template< typename T >
+	struct sliding_median
+	{
+		sliding_median( size_t window_size ) : window_( window_size ), next_( 0 ), count_( 0 ) {
+			xo_error_if( window_size == 0, "Window size must be > 0" );
+			sorted_.reserve( window_size );
+		}
+
+		/// add value, removing the oldest value if the window is full, returns the new median
+		T add( const T& value ) {
+			if ( count_ == window_.size() ) {
+				auto it = std::lower_bound( sorted_.begin(), sorted_.end(), window_[ next_ ] );
+				sorted_.erase( it );
+			}
+			else ++count_;
+			window_[ next_ ] = value;
+			next_ = next_ + 1 == window_.size() ? 0 : next_ + 1;
+			sorted_.insert( std::upper_bound( sorted_.begin(), sorted_.end(), value ), value );
+			return median();
+		}
+		T operator()( const T& value ) { return add( value ); }
+
+		/// median of the values in the window
+		T median() const {
+			xo_assert( count_ > 0 );
+			auto h = count_ / 2;
+			return count_ % 2 == 1 ? sorted_[ h ] : ( sorted_[ h - 1 ] + sorted_[ h ] ) / 2;
+		}
+		T operator()() const { return median(); }
+
+		size_t size() const { return count_; }
+		bool empty() const { return count_ == 0; }
+		size_t window_size() const { return window_.size(); }
+		void clear() { sorted_.clear(); next_ = count_ = 0; }
+
+	private:
+		std::vector< T > window_;
+		std::vector< T > sorted_;
+		size_t next_;
+		size_t count_;
+	};
+
+	/// apply a sliding median filter to [b, e), writing one value per input value to out
+	template< typename I, typename O > O sliding_median_filter( I b, I e, size_t window_size, O out ) {
+		sliding_median< typename std::iterator_traits< I >::value_type > sm( window_size );
+		for ( ; b != e; ++b, ++out )
+			*out = sm.add( *b );
+		return out;
+	}
+}
@@ -113,6 +113,28 @@ namespace xo
 		return s;
 	}
 
+	std::string_view char_stream::get_view_until( const char* stop_chars )
+	{
+		const char* p = cur_pos;
+		while ( p != buffer_end && !strchr( stop_chars, *p ) )
+			++p;
+		std::string_view v( cur_pos, size_t( p - cur_pos ) );
+		cur_pos = p;
+		test_eof();
+		return v;
+	}
+
+	std::string_view char_stream::get_view_while( const char* span_chars )
+	{
+		const char* p = cur_pos;
+		while ( p != buffer_end && *p && strchr( span_chars, *p ) )
+			++p;
+		std::string_view v( cur_pos, size_t( p - cur_pos ) );
+		cur_pos = p;
+		test_eof();
+		return v;
+	}
+
 	size_t char_stream::line_number() const
 	{
 		size_t num = 1;
@@ -2,6 +2,7 @@
 
 #include <cstring>
 #include <vector>
+#include <string_view>
 
 #include "xo/xo_types.h"
 #include "xo/string/string_type.h"
@@ -53,6 +54,15 @@ namespace xo
 		char getc() { if ( !test_eof() ) return *cur_pos++; else return '\0'; }
 		char peekc() { if ( !test_eof() ) return *cur_pos; else return '\0'; }
 
+		/// get characters up to any of stop_chars, returns a view into the buffer
+		std::string_view get_view_until( const char* stop_chars );
+
+		/// get characters as long as they are any of span_chars, returns a view into the buffer
+		std::string_view get_view_while( const char* span_chars );
+
+		/// skip delimiter characters
+		void skip_delimiters() { while ( !test_eof() && strchr( delimiters_.c_str(), *cur_pos ) ) ++cur_pos; }
+
 		bool seek( const string& s );
 		bool seek_past( const string& s );
 		bool try_get( const string& s );
@@ -67,7 +77,6 @@ namespace xo
 	private:
 		void initialize( const char* b, size_t len );
 		const string* check_operator( const char* s );
-		void skip_delimiters() { while ( !test_eof() && strchr( delimiters_.c_str(), *cur_pos ) ) ++cur_pos; }
 		bool test_eof() { if ( cur_pos == buffer_end ) { buffer_flags.set< eof_flag >(); return true; } else return false; }
 		void process_end_pos() { if ( cur_pos == cur_pos_end ) buffer_flags.set< fail_flag >(); else cur_pos = cur_pos_end; }
 
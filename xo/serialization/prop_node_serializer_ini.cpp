@@ -3,10 +3,68 @@
 #include "xo/system/error_code.h"
 #include "xo/container/prop_node.h"
 #include "xo/string/string_tools.h"
+#include "xo/utility/hash.h"
 #include <iostream>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <cstring>
 
 namespace xo
 {
+	/// buffered line reader for ini files, lines can be of any length
+	struct ini_line_reader
+	{
+		ini_line_reader( std::istream& str, size_t buffer_size = 8192 ) :
+			str_( str ), buffer_( buffer_size ), pos_( 0 ), end_( 0 ), line_number_( 0 ) {}
+
+		/// get next line without trailing '\n', returns false at end of stream
+		bool get_line( std::string_view& line ) {
+			line_.clear();
+			bool has_data = false;
+			while ( pos_ < end_ || fill_buffer() ) {
+				const char* b = buffer_.data() + pos_;
+				const char* e = buffer_.data() + end_;
+				if ( auto* nl = static_cast<const char*>( std::memchr( b, '\n', e - b ) ) ) {
+					pos_ = nl - buffer_.data() + 1;
+					++line_number_;
+					if ( !has_data )
+						line = std::string_view( b, nl - b ); // line is in buffer, no need to copy
+					else line = line_.append( b, nl );
+					return true;
+				}
+				else {
+					// line continues after the end of the buffer
+					line_.append( b, e );
+					pos_ = end_;
+					has_data = true;
+				}
+			}
+			if ( has_data ) {
+				++line_number_;
+				line = line_;
+			}
+			return has_data;
+		}
+
+		size_t line_number() const { return line_number_; }
+
+	private:
+		bool fill_buffer() {
+			str_.read( buffer_.data(), buffer_.size() );
+			pos_ = 0;
+			end_ = static_cast<size_t>( str_.gcount() );
+			return end_ > 0;
+		}
+
+		std::istream& str_;
+		std::vector< char > buffer_;
+		size_t pos_;
+		size_t end_;
+		size_t line_number_;
+		string line_;
+	};
+
 	std::ostream& prop_node_serializer_ini::write_stream( std::ostream& str ) const
 	{
 		xo_assert( write_pn_ );
@@ -14,12 +72,12 @@ namespace xo
 		{
 			if ( e.second.size() > 0 ) // group item
 			{
-				str << '[' << e.first << ']' << std::endl;
+				str << '[' << e.first << ']' << '\n';
 				for ( auto& e2 : e.second )
-					str << e2.first << "=" << e2.second.raw_value() << std::endl;
+					str << e2.first << '=' << e2.second.raw_value() << '\n';
 			}
 			else if ( e.second.has_value() ) // main item
-				str << e.first << "=" << e.second.raw_value() << std::endl;
+				str << e.first << '=' << e.second.raw_value() << '\n';
 		}
 		return str;
 	}
@@ -29,31 +87,40 @@ namespace xo
 		xo_assert( read_pn_ );
 		prop_node* cur_group = read_pn_;
 
-		while ( str.good() )
-		{
-			char buf[ 1024 ];
-			str.getline( buf, sizeof( buf ) );
-			if ( str.fail() && !str.eof() )
-				return set_error_or_throw( ec_, "Error reading ini file, line too long" ), str;
+		// index of keys in the current group, used to detect duplicates without linear search
+		std::unordered_map< hash_t, index_t > key_indices;
+		for ( index_t i = 0; i < read_pn_->size(); ++i )
+			key_indices.try_emplace( hash( read_pn_->get_key( i ) ), i );
 
-			string line( buf );
+		ini_line_reader reader( str );
+		for ( std::string_view line; reader.get_line( line ); )
+		{
+			line = trim_str( line );
 
-			if ( line.length() == 0 ) // empty line
+			if ( line.empty() ) // empty line
 				continue;
 
-			if ( line[ 0 ] == ';' ) // comment
+			if ( line.front() == ';' ) // comment
 				continue;
 
-			if ( line.size() > 2 && line[ 0 ] == '[' && line[ line.size() - 1 ] == ']' )
+			if ( line.size() > 2 && line.front() == '[' && line.back() == ']' )
 			{
-				cur_group = &read_pn_->add_child( line.substr( 1, line.size() - 2 ) );
+				cur_group = &read_pn_->add_child( string( line.substr( 1, line.size() - 2 ) ) );
+				key_indices.clear();
 				continue;
 			}
 
 			// must be a key = value line
-			auto kvp = make_key_value_str( line );
-			xo_error_if( kvp.first == line, "Error loading ini file, expected '='" );
-			cur_group->set( kvp.first, kvp.second );
+			if ( line.find( '=' ) == std::string_view::npos )
+				return set_error_or_throw( ec_, stringf( "Error loading ini file, expected '=' at line %d", int( reader.line_number() ) ) ), str;
+			auto [key, value] = make_key_value_str( line );
+
+			auto [it, is_new_key] = key_indices.try_emplace( hash( key ), cur_group->size() );
+			if ( is_new_key )
+				cur_group->add_child( string( key ), prop_node( string( value ) ) );
+			else if ( cur_group->get_key( it->second ) == key )
+				cur_group->get_child( it->second ) = prop_node( string( value ) ); // duplicate key, overwrite
+			else cur_group->set( string( key ), string( value ) ); // hash collision, fall back to regular search
 		}
 		return str;
 	}
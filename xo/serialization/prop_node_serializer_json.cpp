@@ -0,0 +1,481 @@
+#include "prop_node_serializer_json.h"
+
+#include "xo/serialization/char_stream.h"
+#include "xo/container/prop_node.h"
+#include "xo/string/string_tools.h"
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+namespace xo
+{
+	bool is_json_number( std::string_view s )
+	{
+		auto p = s.begin(), e = s.end();
+		auto digits = [&]() { auto b = p; while ( p != e && *p >= '0' && *p <= '9' ) ++p; return p != b; };
+		if ( p != e && *p == '-' ) ++p;
+		if ( p == e ) return false;
+		if ( *p == '0' ) ++p;
+		else if ( !digits() ) return false;
+		if ( p != e && *p == '.' && ( ++p, !digits() ) ) return false;
+		if ( p != e && ( *p == 'e' || *p == 'E' ) ) {
+			if ( ++p != e && ( *p == '+' || *p == '-' ) ) ++p;
+			if ( !digits() ) return false;
+		}
+		return p == e;
+	}
+
+	namespace
+	{
+		const char* const json_number_chars = "+-.0123456789eE";
+		const char* const json_literal_chars = "abcdefghijklmnopqrstuvwxyz";
+
+		void json_error( const char_stream& str, error_code* ec, const string& message )
+		{
+			set_error_or_throw( ec, stringf( "Error parsing line %d: ", int( str.line_number() ) ) + message );
+		}
+
+		void append_utf8( string& s, unsigned int cp )
+		{
+			if ( cp < 0x80 ) s += char( cp );
+			else if ( cp < 0x800 ) { s += char( 0xc0 | ( cp >> 6 ) ); s += char( 0x80 | ( cp & 0x3f ) ); }
+			else if ( cp < 0x10000 ) { s += char( 0xe0 | ( cp >> 12 ) ); s += char( 0x80 | ( ( cp >> 6 ) & 0x3f ) ); s += char( 0x80 | ( cp & 0x3f ) ); }
+			else { s += char( 0xf0 | ( cp >> 18 ) ); s += char( 0x80 | ( ( cp >> 12 ) & 0x3f ) ); s += char( 0x80 | ( ( cp >> 6 ) & 0x3f ) ); s += char( 0x80 | ( cp & 0x3f ) ); }
+		}
+
+		bool read_json_hex4( char_stream& str, unsigned int& cp )
+		{
+			cp = 0;
+			for ( int i = 0; i < 4; ++i )
+			{
+				char c = str.getc();
+				if ( c >= '0' && c <= '9' ) cp = cp * 16 + ( c - '0' );
+				else if ( ( c | 0x20 ) >= 'a' && ( c | 0x20 ) <= 'f' ) cp = cp * 16 + ( ( c | 0x20 ) - 'a' + 10 );
+				else return false;
+			}
+			return true;
+		}
+
+		bool is_high_surrogate( unsigned int cp ) { return cp >= 0xd800 && cp < 0xdc00; }
+		bool is_low_surrogate( unsigned int cp ) { return cp >= 0xdc00 && cp < 0xe000; }
+		const unsigned int unicode_replacement_char = 0xfffd;
+
+		/// read string after opening quote into s, which is reused to avoid allocations
+		bool read_json_string( char_stream& str, string& s, error_code* ec )
+		{
+			s.clear();
+			while ( true )
+			{
+				s += str.get_view_until( "\"\\" );
+				char c = str.getc();
+				if ( c == '\"' )
+					return true;
+				else if ( c == '\\' )
+				{
+					switch ( c = str.getc() )
+					{
+					case '\"': case '\\': case '/': s += c; break;
+					case 'b': s += '\b'; break;
+					case 'f': s += '\f'; break;
+					case 'n': s += '\n'; break;
+					case 'r': s += '\r'; break;
+					case 't': s += '\t'; break;
+					case 'u':
+					{
+						unsigned int cp, cp2;
+						if ( !read_json_hex4( str, cp ) )
+							return json_error( str, ec, "Invalid unicode escape sequence" ), false;
+						while ( is_high_surrogate( cp ) )
+						{
+							if ( !str.try_get( "\\u" ) )
+							{
+								cp = unicode_replacement_char;
+								break;
+							}
+							if ( !read_json_hex4( str, cp2 ) )
+								return json_error( str, ec, "Invalid unicode escape sequence" ), false;
+							if ( is_low_surrogate( cp2 ) )
+							{
+								cp = 0x10000 + ( ( cp - 0xd800 ) << 10 ) + ( cp2 - 0xdc00 ); // surrogate pair
+								break;
+							}
+							append_utf8( s, unicode_replacement_char ); // unpaired high surrogate
+							cp = cp2;
+						}
+						if ( is_low_surrogate( cp ) )
+							cp = unicode_replacement_char; // unpaired low surrogate
+						append_utf8( s, cp );
+						break;
+					}
+					default: return json_error( str, ec, "Invalid escape sequence" ), false;
+					}
+				}
+				else return json_error( str, ec, "Unterminated string" ), false;
+			}
+		}
+
+		/// scratch buffers that are reused while parsing to avoid allocations
+		struct json_read_buffers
+		{
+			string str;
+			std::vector< std::string_view > numbers;
+		};
+
+		bool is_json_number_start( char c ) { return c == '-' || ( c >= '0' && c <= '9' ); }
+
+		bool read_json_value( char_stream& str, prop_node& pn, json_read_buffers& buf, error_code* ec );
+
+		bool read_json_array( char_stream& str, prop_node& pn, json_read_buffers& buf, error_code* ec )
+		{
+			str.skip_delimiters();
+			if ( str.try_get( ']' ) )
+				return true;
+
+			// fast path for leading numbers: collect views and add all children in one go
+			auto& nums = buf.numbers;
+			nums.clear();
+			bool done = false;
+			while ( !done && is_json_number_start( str.peekc() ) )
+			{
+				auto v = str.get_view_while( json_number_chars );
+				if ( !is_json_number( v ) )
+					return json_error( str, ec, "Invalid number: " + string( v ) ), false;
+				nums.push_back( v );
+				str.skip_delimiters();
+				if ( str.try_get( ']' ) )
+					done = true;
+				else if ( str.try_get( ',' ) )
+					str.skip_delimiters();
+				else return json_error( str, ec, "Expected ',' or ']'" ), false;
+			}
+			if ( !nums.empty() )
+			{
+				pn.reserve( pn.size() + nums.size() );
+				for ( auto v : nums )
+					pn.add_child().set_value( string( v ) );
+				if ( done )
+					return true;
+			}
+
+			// regular path for mixed arrays
+			while ( true )
+			{
+				if ( !read_json_value( str, pn.add_child(), buf, ec ) )
+					return false;
+				str.skip_delimiters();
+				if ( str.try_get( ']' ) )
+					return true;
+				else if ( !str.try_get( ',' ) )
+					return json_error( str, ec, "Expected ',' or ']'" ), false;
+			}
+		}
+
+		bool read_json_object( char_stream& str, prop_node& pn, json_read_buffers& buf, error_code* ec )
+		{
+			str.skip_delimiters();
+			if ( str.try_get( '}' ) )
+				return true;
+
+			while ( true )
+			{
+				str.skip_delimiters();
+				if ( !str.try_get( '\"' ) )
+					return json_error( str, ec, "Expected key" ), false;
+				if ( !read_json_string( str, buf.str, ec ) )
+					return false;
+				auto& child = pn.add_child( buf.str );
+				str.skip_delimiters();
+				if ( !str.try_get( ':' ) )
+					return json_error( str, ec, "Expected ':' after " + buf.str ), false;
+				if ( !read_json_value( str, child, buf, ec ) )
+					return false;
+				str.skip_delimiters();
+				if ( str.try_get( '}' ) )
+					return true;
+				else if ( !str.try_get( ',' ) )
+					return json_error( str, ec, "Expected ',' or '}'" ), false;
+			}
+		}
+
+		bool read_json_value( char_stream& str, prop_node& pn, json_read_buffers& buf, error_code* ec )
+		{
+			str.skip_delimiters();
+			switch ( char c = str.peekc() )
+			{
+			case '{': str.getc(); return read_json_object( str, pn, buf, ec );
+			case '[': str.getc(); return read_json_array( str, pn, buf, ec );
+			case '\"':
+				str.getc();
+				if ( !read_json_string( str, buf.str, ec ) )
+					return false;
+				pn.set_value( string( buf.str ) );
+				return true;
+			default:
+				if ( is_json_number_start( c ) )
+				{
+					auto v = str.get_view_while( json_number_chars );
+					if ( !is_json_number( v ) )
+						return json_error( str, ec, "Invalid number: " + string( v ) ), false;
+					pn.set_value( string( v ) );
+					return true;
+				}
+				else
+				{
+					auto v = str.get_view_while( json_literal_chars );
+					if ( v == "true" || v == "false" )
+						pn.set_value( string( v ) );
+					else if ( v != "null" )
+						return json_error( str, ec, v.empty() ? "Unexpected end of stream" : "Invalid value: " + string( v ) ), false;
+					return true;
+				}
+			}
+		}
+
+		prop_node parse_json( char_stream& str, error_code* ec )
+		{
+			str.set_delimiter_chars( " \n\r\t" );
+			prop_node root;
+			json_read_buffers buf;
+			if ( read_json_value( str, root, buf, ec ) )
+			{
+				str.skip_delimiters();
+				if ( !str.eof() )
+					json_error( str, ec, "Unexpected characters after JSON value" );
+			}
+			return root;
+		}
+
+		void write_json_string( std::ostream& str, const string& s )
+		{
+			str << '\"';
+			auto b = s.data(), e = s.data() + s.size();
+			for ( auto p = b; p != e; ++p )
+			{
+				auto c = static_cast<unsigned char>( *p );
+				if ( c >= 0x20 && c != '\"' && c != '\\' )
+					continue;
+				str.write( b, p - b );
+				b = p + 1;
+				switch ( c )
+				{
+				case '\"': str << "\\\""; break;
+				case '\\': str << "\\\\"; break;
+				case '\n': str << "\\n"; break;
+				case '\r': str << "\\r"; break;
+				case '\t': str << "\\t"; break;
+				case '\b': str << "\\b"; break;
+				case '\f': str << "\\f"; break;
+				default: str << stringf( "\\u%04x", int( c ) );
+				}
+			}
+			str.write( b, e - b );
+			str << '\"';
+		}
+
+		void write_json_scalar( std::ostream& str, const string& v )
+		{
+			if ( v == "true" || v == "false" || is_json_number( v ) )
+				str << v;
+			else write_json_string( str, v );
+		}
+
+		bool is_json_number_array( const prop_node& pn )
+		{
+			for ( auto& c : pn )
+				if ( !c.first.empty() || c.second.size() > 0 || !is_json_number( c.second.peek_raw_value() ) )
+					return false;
+			return true;
+		}
+
+		void write_json_node( std::ostream& str, const prop_node& pn, int level )
+		{
+			if ( pn.size() == 0 )
+			{
+				// prop_node has no container type, empty arrays and objects are read as nodes without value
+				if ( pn.has_value() )
+					write_json_scalar( str, pn.raw_value() );
+				else str << "null";
+				return;
+			}
+
+			if ( pn.is_array() )
+			{
+				if ( is_json_number_array( pn ) )
+				{
+					// fast path for numeric arrays: single line without quoting checks
+					str << "[ ";
+					for ( auto it = pn.begin(); it != pn.end(); ++it )
+					{
+						if ( it != pn.begin() ) str << ", ";
+						str << it->second.raw_value();
+					}
+					str << " ]";
+					return;
+				}
+
+				str << "[\n";
+				for ( auto it = pn.begin(); it != pn.end(); ++it )
+				{
+					if ( it != pn.begin() ) str << ",\n";
+					str << string( level + 1, '\t' );
+					write_json_node( str, it->second, level + 1 );
+				}
+				str << '\n' << string( level, '\t' ) << ']';
+			}
+			else
+			{
+				str << "{\n";
+				for ( auto it = pn.begin(); it != pn.end(); ++it )
+				{
+					if ( it != pn.begin() ) str << ",\n";
+					str << string( level + 1, '\t' );
+					write_json_string( str, it->first );
+					str << ": ";
+					write_json_node( str, it->second, level + 1 );
+				}
+				str << '\n' << string( level, '\t' ) << '}';
+			}
+		}
+	}
+
+	prop_node parse_json( const char* str, error_code* ec )
+	{
+		char_stream stream( str );
+		return parse_json( stream, ec );
+	}
+
+	std::istream& prop_node_serializer_json::read_stream( std::istream& str )
+	{
+		xo_assert( read_pn_ );
+		char_stream stream( string( std::istreambuf_iterator<char>( str ), {} ) );
+		*read_pn_ = parse_json( stream, ec_ );
+		return str;
+	}
+
+	std::ostream& prop_node_serializer_json::write_stream( std::ostream& str ) const
+	{
+		xo_assert( write_pn_ );
+		write_json_node( str, *write_pn_, 0 );
+		return str << '\n';
+	}
+
+	json_struct_reader::json_struct_reader( const char* str, error_code* ec ) :
+		str_( str, " \n\r\t" ), ec_( ec ), first_item_( false ), failed_( false )
+	{}
+
+	json_struct_reader::json_struct_reader( string&& str, error_code* ec ) :
+		str_( std::move( str ), " \n\r\t" ), ec_( ec ), first_item_( false ), failed_( false )
+	{}
+
+	bool json_struct_reader::error( const string& message )
+	{
+		if ( !failed_ )
+		{
+			failed_ = true;
+			json_error( str_, ec_, message );
+		}
+		return false;
+	}
+
+	bool json_struct_reader::next_item( char close )
+	{
+		if ( failed_ )
+			return false;
+		str_.skip_delimiters();
+		if ( str_.try_get( close ) )
+			return first_item_ = false;
+		if ( !first_item_ && !str_.try_get( ',' ) )
+			return error( stringf( "Expected ',' or '%c'", close ) );
+		first_item_ = false;
+		str_.skip_delimiters();
+		return true;
+	}
+
+	bool json_struct_reader::begin_object()
+	{
+		str_.skip_delimiters();
+		if ( !str_.try_get( '{' ) )
+			return error( "Expected '{'" );
+		return first_item_ = true;
+	}
+
+	bool json_struct_reader::next_key( std::string_view& key )
+	{
+		if ( !next_item( '}' ) )
+			return false;
+		if ( !str_.try_get( '\"' ) )
+			return error( "Expected key" );
+		if ( !read_json_string( str_, key_, ec_ ) )
+			return failed_ = true, false;
+		str_.skip_delimiters();
+		if ( !str_.try_get( ':' ) )
+			return error( "Expected ':' after " + key_ );
+		key = key_;
+		return true;
+	}
+
+	bool json_struct_reader::begin_array()
+	{
+		str_.skip_delimiters();
+		if ( !str_.try_get( '[' ) )
+			return error( "Expected '['" );
+		return first_item_ = true;
+	}
+
+	bool json_struct_reader::next_element()
+	{
+		return next_item( ']' );
+	}
+
+	const string* json_struct_reader::read_scalar()
+	{
+		str_.skip_delimiters();
+		char c = str_.peekc();
+		if ( c == '\"' )
+		{
+			str_.getc();
+			if ( !read_json_string( str_, token_, ec_ ) )
+				return failed_ = true, nullptr;
+		}
+		else if ( is_json_number_start( c ) )
+		{
+			auto v = str_.get_view_while( json_number_chars );
+			if ( !is_json_number( v ) )
+				return error( "Invalid number: " + string( v ) ), nullptr;
+			token_.assign( v );
+		}
+		else
+		{
+			auto v = str_.get_view_while( json_literal_chars );
+			if ( v == "null" )
+				token_.clear();
+			else if ( v == "true" || v == "false" )
+				token_.assign( v );
+			else return error( v.empty() ? "Expected value" : "Invalid value: " + string( v ) ), nullptr;
+		}
+		return &token_;
+	}
+
+	bool json_struct_reader::skip_value()
+	{
+		str_.skip_delimiters();
+		char c = str_.peekc();
+		if ( c == '{' || c == '[' )
+		{
+			str_.getc();
+			for ( int level = 1; level > 0; )
+			{
+				str_.get_view_until( "{}[]\"" );
+				switch ( str_.getc() )
+				{
+				case '{': case '[': ++level; break;
+				case '}': case ']': --level; break;
+				case '\"': if ( !read_json_string( str_, token_, ec_ ) ) return failed_ = true, false; break;
+				default: return error( "Unexpected end of stream" );
+				}
+			}
+			return true;
+		}
+		else return read_scalar() != nullptr;
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "prop_node_serializer.h"
+#include "xo/serialization/char_stream.h"
+#include <string_view>
+
+namespace xo
+{
+	/// JSON serializer: objects map to keyed children, arrays to children with empty keys
+	/// and scalars to values. prop_node has no container type, so null and empty arrays and
+	/// objects are read as nodes without value, which are written as null. Values of nodes that
+	/// also have children cannot be represented in JSON and are not written.
+	struct XO_API prop_node_serializer_json : public prop_node_serializer
+	{
+		prop_node_serializer_json() : prop_node_serializer() {}
+		prop_node_serializer_json( const prop_node& pn, error_code* ec = nullptr, const path& file_folder = path() ) : prop_node_serializer( pn, ec, file_folder ) {}
+		prop_node_serializer_json( prop_node& pn, error_code* ec = nullptr, const path& file_folder = path() ) : prop_node_serializer( pn, ec, file_folder ) {}
+
+		virtual std::istream& read_stream( std::istream& str ) override;
+		virtual std::ostream& write_stream( std::ostream& str ) const override;
+	};
+
+	/// token-level json reader, used by read_struct() to read directly into reflected structs
+	class XO_API json_struct_reader
+	{
+	public:
+		explicit json_struct_reader( const char* str, error_code* ec = nullptr );
+		explicit json_struct_reader( string&& str, error_code* ec = nullptr );
+
+		bool begin_object();
+		bool next_key( std::string_view& key );
+		bool begin_array();
+		bool next_element();
+		const string* read_scalar();
+		bool skip_value();
+
+		bool good() const { return !failed_; }
+		bool error( const string& message );
+
+	private:
+		bool next_item( char close );
+
+		char_stream str_;
+		error_code* ec_;
+		string token_;
+		string key_;
+		bool first_item_;
+		bool failed_;
+	};
+
+	XO_API prop_node parse_json( const char* str, error_code* ec = nullptr );
+
+	/// check if a string is a number according to the JSON grammar
+	XO_API bool is_json_number( std::string_view s );
+}
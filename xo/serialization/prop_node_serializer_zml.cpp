@@ -274,4 +274,133 @@ namespace xo
 	{
 		prop_node_serializer_zml().save_file( pn, filename, ec );
 	}
+
+	zml_struct_reader::zml_struct_reader( const char* str, error_code* ec ) :
+		str_( str ), ec_( ec ), has_peeked_token_( false ), at_root_( true ), braceless_root_( false ), depth_( 0 ), failed_( false )
+	{
+		initialize();
+	}
+
+	zml_struct_reader::zml_struct_reader( string&& str, error_code* ec ) :
+		str_( std::move( str ) ), ec_( ec ), has_peeked_token_( false ), at_root_( true ), braceless_root_( false ), depth_( 0 ), failed_( false )
+	{
+		initialize();
+	}
+
+	void zml_struct_reader::initialize()
+	{
+		str_.set_operators( { "=", ": ", "{", "}", "[", "]", "#", "//", "/*", "*/" } );
+		str_.set_delimiter_chars( " \n\r\t\v" );
+		str_.set_quotation_chars( "\"'" );
+	}
+
+	const string& zml_struct_reader::get_token()
+	{
+		if ( has_peeked_token_ )
+			has_peeked_token_ = false;
+		else token_ = get_zml_token( str_, ec_ );
+		return token_;
+	}
+
+	const string& zml_struct_reader::peek_token()
+	{
+		if ( !has_peeked_token_ )
+		{
+			token_ = get_zml_token( str_, ec_ );
+			has_peeked_token_ = true;
+		}
+		return token_;
+	}
+
+	bool zml_struct_reader::error( const string& message )
+	{
+		if ( !failed_ )
+		{
+			failed_ = true;
+			zml_error( str_, ec_, message );
+		}
+		return false;
+	}
+
+	bool zml_struct_reader::begin_object()
+	{
+		++depth_;
+		if ( at_root_ )
+		{
+			// root level objects have no braces
+			at_root_ = false;
+			return braceless_root_ = true;
+		}
+		else if ( get_token() == "{" )
+			return true;
+		else return error( "Expected '{'" );
+	}
+
+	bool zml_struct_reader::next_key( std::string_view& key )
+	{
+		if ( failed_ )
+			return false;
+		auto& t = get_token();
+		if ( t == "}" || ( t.empty() && depth_ == 1 && braceless_root_ ) )
+			return --depth_, false; // end of group or end of root
+		else if ( t.empty() )
+			return error( "Unexpected end of stream" );
+		else if ( !isalpha( t[ 0 ] ) )
+			return error( "Invalid label " + t );
+
+		key_ = t;
+		auto& eq = peek_token();
+		if ( eq == "=" || eq == ": " )
+			get_token();
+		else if ( eq != "{" && eq != "[" )
+			return error( "Expected '=', ':', '{' or '['" );
+		key = key_;
+		return true;
+	}
+
+	bool zml_struct_reader::begin_array()
+	{
+		at_root_ = false;
+		if ( get_token() == "[" )
+			return true;
+		else return error( "Expected '['" );
+	}
+
+	bool zml_struct_reader::next_element()
+	{
+		if ( failed_ )
+			return false;
+		auto& t = peek_token();
+		if ( t == "]" )
+			return get_token(), false;
+		else if ( t.empty() )
+			return error( "'[' has no matching ']'" );
+		else return true;
+	}
+
+	const string* zml_struct_reader::read_scalar()
+	{
+		at_root_ = false;
+		auto& t = get_token();
+		if ( t == "{" || t == "[" || t == "}" || t == "]" )
+			return error( "Expected value instead of " + t ), nullptr;
+		return &t;
+	}
+
+	bool zml_struct_reader::skip_value()
+	{
+		at_root_ = false;
+		auto& t = get_token();
+		if ( t == "{" || t == "[" )
+		{
+			for ( int level = 1; level > 0; )
+			{
+				auto& t2 = get_token();
+				if ( t2 == "{" || t2 == "[" ) ++level;
+				else if ( t2 == "}" || t2 == "]" ) --level;
+				else if ( t2.empty() ) return error( "Unexpected end of stream" );
+			}
+		}
+		return true;
+	}
 }
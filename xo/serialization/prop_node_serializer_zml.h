@@ -1,6 +1,8 @@
 #pragma once
 
 #include "prop_node_serializer.h"
+#include "xo/serialization/char_stream.h"
+#include <string_view>
 
 namespace xo
 {
@@ -23,6 +25,40 @@ namespace xo
 		virtual std::ostream& write_stream( std::ostream& str ) const override;
 	};
 
+	/// token-level zml reader, used by read_struct() to read directly into reflected structs
+	/// supports key / value pairs, groups and arrays; includes, references and macros are not supported
+	class XO_API zml_struct_reader
+	{
+	public:
+		explicit zml_struct_reader( const char* str, error_code* ec = nullptr );
+		explicit zml_struct_reader( string&& str, error_code* ec = nullptr );
+
+		bool begin_object();
+		bool next_key( std::string_view& key );
+		bool begin_array();
+		bool next_element();
+		const string* read_scalar();
+		bool skip_value();
+
+		bool good() const { return !failed_; }
+		bool error( const string& message );
+
+	private:
+		void initialize();
+		const string& get_token();
+		const string& peek_token();
+
+		char_stream str_;
+		error_code* ec_;
+		string token_;
+		string key_;
+		bool has_peeked_token_;
+		bool at_root_; // no value has been started yet
+		bool braceless_root_; // the root value is an object, which has no braces
+		int depth_;
+		bool failed_;
+	};
+
 	XO_API prop_node load_zml( const path& filename, error_code* ec = nullptr, path parent_folder = path() );
 	XO_API void save_zml( const prop_node& pn, const path& filename, error_code* ec = nullptr );
 	XO_API prop_node parse_zml( const char* str, error_code* ec = nullptr );
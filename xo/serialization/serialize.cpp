@@ -3,6 +3,7 @@
 #include "prop_node_serializer_xml.h"
 #include "prop_node_serializer_ini.h"
 #include "prop_node_serializer_zml.h"
+#include "prop_node_serializer_json.h"
 #include <fstream>
 #include "xo/container/prop_node.h"
 
@@ -13,7 +14,8 @@ namespace xo
 		static factory<prop_node_serializer> f = factory<prop_node_serializer>()
 			.register_type< prop_node_serializer_xml >( "xml" )
 			.register_type< prop_node_serializer_ini >( "ini" )
-			.register_type< prop_node_serializer_zml >( "zml" );
+			.register_type< prop_node_serializer_zml >( "zml" )
+			.register_type< prop_node_serializer_json >( "json" );
 
 		return f;
 	}
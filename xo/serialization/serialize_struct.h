@@ -0,0 +1,150 @@
+#pragma once
+
+#include "xo/xo_types.h"
+#include "xo/utility/reflection.h"
+#include "xo/string/string_cast.h"
+#include "xo/system/error_code.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace xo
+{
+	template< typename T > struct is_std_vector : std::false_type {};
+	template< typename T, typename A > struct is_std_vector< std::vector< T, A > > : std::true_type {};
+
+	template< typename R, typename T > bool read_struct( R& reader, T& v );
+
+	/// read field I of reflected struct T, used to build a field dispatch table
+	template< typename R, typename T, size_t I > bool read_struct_field( R& reader, T& v ) {
+		return read_struct( reader, v.*( std::get< I >( reflect_fields< T >() ).member ) );
+	}
+
+	template< typename R, typename T, size_t... I >
+	constexpr auto make_read_struct_field_table( std::index_sequence< I... > ) {
+		using read_fn = bool( * )( R&, T& );
+		return std::array< read_fn, sizeof...( I ) >{ &read_struct_field< R, T, I >... };
+	}
+
+	/// read value directly from a zml_struct_reader or json_struct_reader into v, without building a prop_node
+	/// reflected structs are read by field name, unknown fields are skipped
+	template< typename R, typename T > bool read_struct( R& reader, T& v ) {
+		if constexpr ( is_reflected_v< T > ) {
+			static constexpr auto read_fields = make_read_struct_field_table< R, T >( std::make_index_sequence< reflect_field_count< T >() >() );
+			if ( !reader.begin_object() )
+				return false;
+			for ( std::string_view key; reader.next_key( key ); ) {
+				if ( auto idx = reflect_field_hash< T >.find( key ); idx != no_index ) {
+					if ( !read_fields[ idx ]( reader, v ) )
+						return false;
+				}
+				else if ( !reader.skip_value() )
+					return false;
+			}
+			return reader.good();
+		}
+		else if constexpr ( is_std_vector< T >::value ) {
+			v.clear();
+			if ( !reader.begin_array() )
+				return false;
+			while ( reader.next_element() )
+				if ( !read_struct( reader, v.emplace_back() ) )
+					return false;
+			return reader.good();
+		}
+		else {
+			auto* s = reader.read_scalar();
+			if ( !s )
+				return false;
+			if ( !from_str( *s, v ) )
+				return reader.error( "Could not convert " + *s );
+			return true;
+		}
+	}
+
+	/// write value to a compact binary stream: reflected fields in declaration order, strings and
+	/// vectors prefixed with a 32-bit size, trivially copyable types as raw bytes
+	template< typename T > void write_struct_binary( std::ostream& str, const T& v ) {
+		if constexpr ( is_reflected_v< T > )
+			for_each_field( v, [&]( std::string_view, const auto& f ) { write_struct_binary( str, f ); } );
+		else if constexpr ( std::is_same_v< T, string > ) {
+			auto n = static_cast<std::uint32_t>( v.size() );
+			str.write( reinterpret_cast<const char*>( &n ), sizeof( n ) );
+			str.write( v.data(), n );
+		}
+		else if constexpr ( is_std_vector< T >::value ) {
+			auto n = static_cast<std::uint32_t>( v.size() );
+			str.write( reinterpret_cast<const char*>( &n ), sizeof( n ) );
+			using value_type = typename T::value_type;
+			if constexpr ( std::is_trivially_copyable_v< value_type > && !is_reflected_v< value_type > && !std::is_same_v< value_type, bool > )
+				str.write( reinterpret_cast<const char*>( v.data() ), n * sizeof( value_type ) );
+			else for ( const auto& e : v )
+				write_struct_binary( str, static_cast<const value_type&>( e ) );
+		}
+		else {
+			static_assert( std::is_trivially_copyable_v< T >, "Type cannot be written to binary stream" );
+			str.write( reinterpret_cast<const char*>( &v ), sizeof( T ) );
+		}
+	}
+
+	/// sizes read from binary streams are not trusted: containers grow in chunks of this size while reading,
+	/// so that a corrupt or truncated stream fails before it can cause a huge allocation
+	constexpr size_t read_struct_binary_chunk_bytes = 1 << 16;
+
+	/// read n trivially copyable elements into v in chunks of read_struct_binary_chunk_bytes
+	template< typename C > bool read_struct_binary_elements( std::istream& str, C& v, size_t n ) {
+		using value_type = typename C::value_type;
+		constexpr size_t chunk = std::max< size_t >( 1, read_struct_binary_chunk_bytes / sizeof( value_type ) );
+		v.clear();
+		for ( size_t i = 0; i < n; ) {
+			const auto m = std::min( chunk, n - i );
+			v.resize( i + m );
+			if ( !str.read( reinterpret_cast<char*>( &v[ i ] ), m * sizeof( value_type ) ) )
+				return false;
+			i += m;
+		}
+		return true;
+	}
+
+	/// read value from a binary stream created with write_struct_binary
+	template< typename T > bool read_struct_binary( std::istream& str, T& v ) {
+		if constexpr ( is_reflected_v< T > ) {
+			for_each_field( v, [&]( std::string_view, auto& f ) { read_struct_binary( str, f ); } );
+			return str.good();
+		}
+		else if constexpr ( std::is_same_v< T, string > ) {
+			std::uint32_t n = 0;
+			if ( str.read( reinterpret_cast<char*>( &n ), sizeof( n ) ) )
+				read_struct_binary_elements( str, v, n );
+			return str.good();
+		}
+		else if constexpr ( is_std_vector< T >::value ) {
+			std::uint32_t n = 0;
+			if ( !str.read( reinterpret_cast<char*>( &n ), sizeof( n ) ) )
+				return false;
+			using value_type = typename T::value_type;
+			if constexpr ( std::is_trivially_copyable_v< value_type > && !is_reflected_v< value_type > && !std::is_same_v< value_type, bool > ) {
+				read_struct_binary_elements( str, v, n );
+			}
+			else {
+				v.clear();
+				v.reserve( std::min< size_t >( n, read_struct_binary_chunk_bytes / sizeof( value_type ) ) );
+				for ( std::uint32_t i = 0; i < n && str.good(); ++i ) {
+					value_type e{};
+					read_struct_binary( str, e );
+					v.push_back( std::move( e ) );
+				}
+			}
+			return str.good();
+		}
+		else {
+			static_assert( std::is_trivially_copyable_v< T >, "Type cannot be read from binary stream" );
+			return bool( str.read( reinterpret_cast<char*>( &v ), sizeof( T ) ) );
+		}
+	}
+}
@@ -3,43 +3,161 @@
 #include "xo/xo_types.h"
 #include "xo/system/assert.h"
 #include "xo/container/container_tools.h"
+#include "xo/utility/perfect_hash.h"
+#include <algorithm>
+#include <array>
+#include <string_view>
+#include <type_traits>
 
 namespace xo
 {
+	namespace detail
+	{
+		template< typename T, typename = void > struct is_less_comparable : std::false_type {};
+		template< typename T > struct is_less_comparable< T, std::void_t< decltype( std::declval< const T& >() < std::declval< const T& >() ) > > : std::true_type {};
+	}
+
 	template< typename T >
 	class dictionary
 	{
 	public:
 		using pair_t = std::pair< T, string >;
-		dictionary( std::initializer_list< pair_t > l ) : data( l ) {}
+		dictionary( std::initializer_list< pair_t > l ) : data( l ), name_index( data.size() ), value_index( data.size() ) {
+			for ( index_t i = 0; i < data.size(); ++i )
+				name_index[ i ] = value_index[ i ] = i;
+			std::stable_sort( name_index.begin(), name_index.end(), [&]( index_t a, index_t b ) { return data[ a ].second < data[ b ].second; } );
+			if constexpr ( detail::is_less_comparable< T >::value )
+				std::stable_sort( value_index.begin(), value_index.end(), [&]( index_t a, index_t b ) { return data[ a ].first < data[ b ].first; } );
+		}
 
 		/// lookup name of element e
 		const string& operator()( const T& e ) const {
-			auto it = find_if( data, [&]( const pair_t& p ) { return e == p.first; } );
-			xo_error_if( it == data.end(), "Could not find element" );
-			return it->second;
+			auto idx = find_value( e );
+			xo_error_if( idx == no_index, "Could not find element" );
+			return data[ idx ].second;
 		}
 
 		/// lookup element with name str
 		const T& operator()( const string& str ) const {
-			auto it = find_if( data, [&]( const pair_t& p ) { return str == p.second; } );
-			xo_error_if( it == data.end(), "Could not find element with name " + str );
-			return it->first;
+			auto idx = find_name( str );
+			xo_error_if( idx == no_index, "Could not find element with name " + str );
+			return data[ idx ].first;
 		}
 
 		/// lookup element with name str or return default
 		const T& operator()( const string& str, const T& value_not_found ) const {
-			auto it = find_if( data, [&]( const pair_t& p ) { return str == p.second; } );
-			return ( it == data.end() ) ? value_not_found : it->first;
+			auto idx = find_name( str );
+			return ( idx == no_index ) ? value_not_found : data[ idx ].first;
 		}
 
 	private:
+		index_t find_name( const string& str ) const {
+			auto it = std::lower_bound( name_index.begin(), name_index.end(), str, [&]( index_t i, const string& s ) { return data[ i ].second < s; } );
+			return ( it != name_index.end() && data[ *it ].second == str ) ? *it : no_index;
+		}
+
+		index_t find_value( const T& e ) const {
+			if constexpr ( detail::is_less_comparable< T >::value ) {
+				auto it = std::lower_bound( value_index.begin(), value_index.end(), e, [&]( index_t i, const T& v ) { return data[ i ].first < v; } );
+				return ( it != value_index.end() && data[ *it ].first == e ) ? *it : no_index;
+			}
+			else {
+				auto it = find_if( data, [&]( const pair_t& p ) { return e == p.first; } );
+				return it != data.end() ? index_t( it - data.begin() ) : no_index;
+			}
+		}
+
 		std::vector< pair_t > data;
+		std::vector< index_t > name_index; // indices of data, sorted by name
+		std::vector< index_t > value_index; // indices of data, sorted by value if T supports operator<
 	};
 
 	template< typename T >
 	dictionary< T > make_dictionary( std::initializer_list< std::pair< T, string > > l ) { return dictionary< T >( l ); }
 
+	/// dictionary with a fixed set of names, built at compile time, with perfect hash name lookup
+	template< typename T, size_t N >
+	class static_dictionary
+	{
+	public:
+		using pair_t = std::pair< T, const char* >;
+		constexpr static_dictionary( const pair_t ( &l )[ N ] ) :
+			values_( get_values( l ) ), value_index_( get_value_index( values_ ) ), names_( get_names( l ) ) {}
+
+		/// lookup name of element e
+		constexpr std::string_view operator()( const T& e ) const {
+			if constexpr ( detail::is_less_comparable< T >::value ) {
+				index_t lo = 0, hi = N;
+				while ( lo < hi ) {
+					const auto mid = ( lo + hi ) / 2;
+					( values_[ value_index_[ mid ] ] < e ? lo = mid + 1 : hi = mid );
+				}
+				if ( lo < N && values_[ value_index_[ lo ] ] == e )
+					return names_.key( value_index_[ lo ] );
+			}
+			else {
+				for ( index_t i = 0; i < N; ++i )
+					if ( values_[ i ] == e )
+						return names_.key( i );
+			}
+			xo_error( "Could not find element" );
+		}
+
+		/// lookup element with name str
+		constexpr const T& operator()( std::string_view str ) const {
+			auto idx = names_.find( str );
+			xo_error_if( idx == no_index, "Could not find element with name " + string( str ) );
+			return values_[ idx ];
+		}
+
+		/// lookup element with name str or return default
+		constexpr const T& operator()( std::string_view str, const T& value_not_found ) const {
+			auto idx = names_.find( str );
+			return ( idx == no_index ) ? value_not_found : values_[ idx ];
+		}
+
+		/// get pointer to element with name str, or nullptr if not found
+		constexpr const T* find( std::string_view str ) const {
+			auto idx = names_.find( str );
+			return ( idx == no_index ) ? nullptr : &values_[ idx ];
+		}
+
+		constexpr size_t size() const { return N; }
+
+	private:
+		static constexpr std::array< T, N > get_values( const pair_t ( &l )[ N ] ) {
+			std::array< T, N > v{};
+			for ( index_t i = 0; i < N; ++i ) v[ i ] = l[ i ].first;
+			return v;
+		}
+		static constexpr std::array< std::string_view, N > get_names( const pair_t ( &l )[ N ] ) {
+			std::array< std::string_view, N > v{};
+			for ( index_t i = 0; i < N; ++i ) v[ i ] = l[ i ].second;
+			return v;
+		}
+
+		// indices of values_, sorted by value if T supports operator<
+		static constexpr std::array< index_t, N > get_value_index( const std::array< T, N >& values ) {
+			std::array< index_t, N > idx{};
+			for ( index_t i = 0; i < N; ++i ) {
+				index_t j = i;
+				if constexpr ( detail::is_less_comparable< T >::value )
+					for ( ; j > 0 && values[ i ] < values[ idx[ j - 1 ] ]; --j )
+						idx[ j ] = idx[ j - 1 ];
+				idx[ j ] = i;
+			}
+			return idx;
+		}
+
+		std::array< T, N > values_;
+		std::array< index_t, N > value_index_;
+		perfect_hash< N > names_;
+	};
+
+	/// make static_dictionary, e.g. constexpr auto dict = make_static_dictionary< fruit >( { { apple, "apple" }, { pear, "pear" } } );
+	template< typename T, size_t N >
+	constexpr static_dictionary< T, N > make_static_dictionary( const std::pair< T, const char* > ( &l )[ N ] ) { return static_dictionary< T, N >( l ); }
+
 	template< typename T >
 	T lookup( const string& value, std::initializer_list< std::pair< const char*, T > > table )
 	{
@@ -48,4 +166,13 @@ namespace xo
 				return entry.second;
 		xo_error( "Unexpected value: " + value );
 	}
+
+	/// lookup value in a static_dictionary, throws if not found
+	template< typename T, size_t N >
+	T lookup( std::string_view value, const static_dictionary< T, N >& table )
+	{
+		if ( auto* v = table.find( value ) )
+			return *v;
+		xo_error( "Unexpected value: " + string( value ) );
+	}
 }
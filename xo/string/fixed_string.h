@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace xo
+{
+	/// string with fixed capacity and inline storage, never allocates; appends beyond capacity are truncated
+	template< size_t N >
+	class fixed_string
+	{
+	public:
+		fixed_string() : size_( 0 ) { data_[ 0 ] = '\0'; }
+		fixed_string( std::string_view s ) : size_( 0 ) { append( s ); }
+		fixed_string( const char* s ) : fixed_string( std::string_view( s ) ) {}
+
+		fixed_string& append( std::string_view s ) {
+			auto n = s.size() < N - size_ ? s.size() : N - size_;
+			std::memcpy( data_ + size_, s.data(), n );
+			size_ += n;
+			data_[ size_ ] = '\0';
+			return *this;
+		}
+		fixed_string& operator+=( std::string_view s ) { return append( s ); }
+		fixed_string& operator+=( char c ) { push_back( c ); return *this; }
+		void push_back( char c ) { if ( size_ < N ) { data_[ size_++ ] = c; data_[ size_ ] = '\0'; } }
+
+		/// append formatted string (printf style)
+		fixed_string& appendf( const char* format, ... ) {
+			va_list args;
+			va_start( args, format );
+			int n = std::vsnprintf( data_ + size_, N + 1 - size_, format, args );
+			va_end( args );
+			if ( n > 0 ) size_ += size_t( n ) < N - size_ ? size_t( n ) : N - size_;
+			return *this;
+		}
+
+		void resize( size_t n ) { size_ = n < N ? n : N; data_[ size_ ] = '\0'; }
+		void clear() { resize( 0 ); }
+
+		const char* c_str() const { return data_; }
+		const char* data() const { return data_; }
+		size_t size() const { return size_; }
+		bool empty() const { return size_ == 0; }
+		static constexpr size_t capacity() { return N; }
+		bool full() const { return size_ == N; }
+
+		std::string_view view() const { return std::string_view( data_, size_ ); }
+		operator std::string_view() const { return view(); }
+		std::string str() const { return std::string( data_, size_ ); }
+
+		char& operator[]( size_t i ) { return data_[ i ]; }
+		char operator[]( size_t i ) const { return data_[ i ]; }
+		const char* begin() const { return data_; }
+		const char* end() const { return data_ + size_; }
+
+	private:
+		size_t size_;
+		char data_[ N + 1 ];
+	};
+
+	template< size_t N > bool operator==( const fixed_string< N >& a, std::string_view b ) { return a.view() == b; }
+	template< size_t N > bool operator!=( const fixed_string< N >& a, std::string_view b ) { return a.view() != b; }
+}
@@ -0,0 +1,133 @@
+#include "pattern_matcher.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace xo
+{
+	void set_state_bit( std::vector< std::uint64_t >& mask, size_t ofs, size_t state )
+	{
+		mask[ ofs + state / 64 ] |= std::uint64_t( 1 ) << ( state % 64 );
+	}
+
+	/// add states that follow a '*' state, consecutive '*' are merged so a single pass is enough
+	bool close_star_states( std::uint64_t* states, const std::uint64_t* star_mask, size_t words )
+	{
+		std::uint64_t carry = 0, any = 0;
+		for ( size_t i = 0; i < words; ++i )
+		{
+			auto s = states[ i ] & star_mask[ i ];
+			states[ i ] |= ( s << 1 ) | carry;
+			carry = s >> 63;
+			any |= states[ i ];
+		}
+		return any != 0;
+	}
+
+	pattern_matcher::pattern_matcher( std::string_view pattern, std::string_view delimeters ) : words_( 0 )
+	{
+		// create tokens per pattern, merging consecutive '*'
+		std::vector< string > tokens;
+		size_t state_count = 0;
+		for ( auto p : split_str_range( pattern, delimeters ) )
+		{
+			patterns_.emplace_back( p );
+			if ( p.find( '[' ) != std::string_view::npos )
+				fallback_patterns_.emplace_back( p );
+			else
+			{
+				auto& t = tokens.emplace_back();
+				for ( char c : p )
+					if ( c != '*' || t.empty() || t.back() != '*' )
+						t += c;
+				state_count += t.size() + 1;
+			}
+		}
+
+		// each token is a state, the state after the last token of a pattern is a final state
+		words_ = ( state_count + 63 ) / 64;
+		char_masks_.resize( 256 * words_ );
+		star_mask_.resize( words_ );
+		start_mask_.resize( words_ );
+		accept_mask_.resize( words_ );
+		size_t state = 0;
+		for ( auto& t : tokens )
+		{
+			set_state_bit( start_mask_, 0, state );
+			for ( char c : t )
+			{
+				if ( c == '*' )
+					set_state_bit( star_mask_, 0, state );
+				else if ( c == '?' )
+					for ( size_t ci = 0; ci < 256; ++ci )
+						set_state_bit( char_masks_, ci * words_, state );
+				else
+				{
+					set_state_bit( char_masks_, size_t( static_cast<unsigned char>( c ) ) * words_, state );
+#ifdef XO_COMP_MSVC
+					// case-insensitive, like pattern_match() on MSVC
+					if ( ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' ) )
+						set_state_bit( char_masks_, size_t( static_cast<unsigned char>( c ^ 0x20 ) ) * words_, state );
+#endif
+				}
+				++state;
+			}
+			set_state_bit( accept_mask_, 0, state++ );
+		}
+		close_star_states( start_mask_.data(), star_mask_.data(), words_ );
+	}
+
+	bool pattern_matcher::match( std::string_view str ) const
+	{
+		const size_t small_words = 8;
+		if ( words_ <= small_words )
+		{
+			std::uint64_t buffer[ 2 * small_words ];
+			return match_impl( str, buffer );
+		}
+		else
+		{
+			std::vector< std::uint64_t > buffer( 2 * words_ );
+			return match_impl( str, buffer.data() );
+		}
+	}
+
+	bool pattern_matcher::match_impl( std::string_view str, std::uint64_t* buffer ) const
+	{
+		if ( words_ > 0 )
+		{
+			// simulate the automaton, the set of active states is stored as bits
+			auto* cur = buffer;
+			auto* next = buffer + words_;
+			std::copy( start_mask_.begin(), start_mask_.end(), cur );
+			bool active = true;
+			for ( auto it = str.begin(); active && it != str.end(); ++it )
+			{
+				const auto* cm = char_masks_.data() + size_t( static_cast<unsigned char>( *it ) ) * words_;
+				std::uint64_t carry = 0;
+				for ( size_t i = 0; i < words_; ++i )
+				{
+					auto m = cur[ i ] & cm[ i ];
+					next[ i ] = ( m << 1 ) | carry | ( cur[ i ] & star_mask_[ i ] );
+					carry = m >> 63;
+				}
+				active = close_star_states( next, star_mask_.data(), words_ );
+				std::swap( cur, next );
+			}
+			if ( active )
+				for ( size_t i = 0; i < words_; ++i )
+					if ( cur[ i ] & accept_mask_[ i ] )
+						return true;
+		}
+
+		if ( !fallback_patterns_.empty() )
+		{
+			string s( str );
+			for ( auto& p : fallback_patterns_ )
+				if ( pattern_match( s, p ) )
+					return true;
+		}
+
+		return false;
+	}
+}
@@ -4,31 +4,50 @@
 #include "xo/string/string_type.h"
 #include "xo/string/string_tools.h"
 #include "xo/container/prop_node.h"
+#include <cstdint>
+#include <string_view>
 #include <vector>
 
 namespace xo
 {
-	class pattern_matcher
+	/// matches strings against a list of glob patterns (name* or name?)
+	/// all patterns are compiled into a single automaton, so each string is tested against all patterns in one pass
+	/// matching is case-sensitive, except on MSVC, where it is case-insensitive like pattern_match()
+	class XO_API pattern_matcher
 	{
 	public:
-		pattern_matcher() {}
-		pattern_matcher( const prop_node& pn ) : patterns( split_str( pn.get<string>(), ";" ) ) {}
-		pattern_matcher( const char* pattern, const char* delimeters = ";" ) : patterns( split_str( pattern, delimeters ) ) {}
-		pattern_matcher( const string& pattern, const char* delimeters = ";" ) : patterns( split_str( pattern, delimeters ) ) {}
-
-		// returns true if string matches pattern
-		bool match( const string& str ) const {
-			for ( auto& p : patterns )
-				if ( pattern_match( str, p ) )
-					return true;
-			return false;
+		pattern_matcher() : words_( 0 ) {}
+		pattern_matcher( const prop_node& pn ) : pattern_matcher( pn.raw_value() ) {}
+		pattern_matcher( std::string_view pattern, std::string_view delimeters = ";" );
+		pattern_matcher( const char* pattern, const char* delimeters = ";" ) : pattern_matcher( std::string_view( pattern ), std::string_view( delimeters ) ) {}
+		pattern_matcher( const string& pattern, const char* delimeters = ";" ) : pattern_matcher( std::string_view( pattern ), std::string_view( delimeters ) ) {}
+
+		/// returns true if string matches any of the patterns
+		bool match( std::string_view str ) const;
+
+		/// test all strings in a range, returns a flag for each element
+		template< typename R > std::vector< bool > match_all( const R& strings ) const {
+			std::vector< bool > result;
+			std::vector< std::uint64_t > buffer( 2 * words_ );
+			for ( const auto& s : strings )
+				result.push_back( match_impl( std::string_view( s ), buffer.data() ) );
+			return result;
 		}
 
-		bool operator()( const string& str ) const { return match( str ); }
-		bool empty() const { return patterns.empty(); }
+		bool operator()( std::string_view str ) const { return match( str ); }
+		bool empty() const { return patterns_.empty(); }
+		const std::vector< string >& patterns() const { return patterns_; }
 
 	private:
-		std::vector< string > patterns;
+		bool match_impl( std::string_view str, std::uint64_t* buffer ) const;
+
+		std::vector< string > patterns_;
+		std::vector< string > fallback_patterns_; // patterns with bracket expressions, matched using pattern_match()
+		size_t words_; // number of 64-bit words per state set
+		std::vector< std::uint64_t > char_masks_; // states that accept a character, words_ per character
+		std::vector< std::uint64_t > star_mask_; // states with a '*'
+		std::vector< std::uint64_t > start_mask_; // initial states
+		std::vector< std::uint64_t > accept_mask_; // final states
 	};
 
 	inline bool is_pattern( const string& s ) {
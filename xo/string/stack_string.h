@@ -1,23 +1,47 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace xo
 {
+	/// string that is built by pushing and popping parts, e.g. for building key paths
+	/// popping keeps the capacity of the string, so only growing beyond the longest path allocates;
+	/// part sizes use inline storage and only allocate for deep nesting
 	class stack_string
 	{
 	public:
-		stack_string() {}
+		stack_string() : depth_( 0 ) {}
 
 		const std::string& str() const { return value_; }
+		std::string_view view() const { return value_; }
+		const char* c_str() const { return value_.c_str(); }
+		bool empty() const { return value_.empty(); }
+		size_t depth() const { return depth_; }
 
-		void set( std::string s ) { value_ = s; sizes_.assign( s.empty() ? 0 : 1, 0 ); }
-		void push_back( const std::string& s ) { sizes_.push_back( value_.size() ); value_ += s; }
-		void pop_back() { value_.resize( sizes_.back() ); sizes_.pop_back(); }
+		void set( std::string_view s ) { value_.assign( s ); depth_ = 0; overflow_sizes_.clear(); if ( !s.empty() ) push_size( 0 ); }
+		void push_back( std::string_view s ) { push_size( value_.size() ); value_.append( s ); }
+		void pop_back() { value_.resize( pop_size() ); }
 
 	private:
+		static constexpr size_t inline_depth = 16;
+		void push_size( size_t s ) {
+			if ( depth_ < inline_depth ) sizes_[ depth_ ] = s;
+			else overflow_sizes_.push_back( s );
+			++depth_;
+		}
+		size_t pop_size() {
+			--depth_;
+			if ( depth_ < inline_depth ) return sizes_[ depth_ ];
+			auto s = overflow_sizes_.back();
+			overflow_sizes_.pop_back();
+			return s;
+		}
+
 		std::string value_;
-		std::vector< size_t > sizes_;
+		size_t sizes_[ inline_depth ];
+		std::vector< size_t > overflow_sizes_;
+		size_t depth_;
 	};
 }
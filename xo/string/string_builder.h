@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace xo
+{
+	/// growable string with N bytes of inline storage, only allocates when the inline storage is exceeded
+	template< size_t N >
+	class basic_string_builder
+	{
+	public:
+		basic_string_builder() : data_( buffer_ ), size_( 0 ), capacity_( N ) { data_[ 0 ] = '\0'; }
+		basic_string_builder( std::string_view s ) : basic_string_builder() { append( s ); }
+		basic_string_builder( const basic_string_builder& other ) : basic_string_builder() { append( other.view() ); }
+		basic_string_builder( basic_string_builder&& other ) noexcept : basic_string_builder() { *this = std::move( other ); }
+		basic_string_builder& operator=( const basic_string_builder& other ) { if ( this != &other ) { clear(); append( other.view() ); } return *this; }
+		basic_string_builder& operator=( basic_string_builder&& other ) noexcept {
+			if ( this == &other )
+				return *this;
+			if ( other.is_inline() ) {
+				clear();
+				append( other.view() );
+			}
+			else {
+				// take over heap storage
+				heap_ = std::move( other.heap_ );
+				data_ = heap_.get();
+				size_ = other.size_;
+				capacity_ = other.capacity_;
+				other.data_ = other.buffer_;
+				other.capacity_ = N;
+			}
+			other.clear();
+			return *this;
+		}
+
+		basic_string_builder& append( std::string_view s ) {
+			reserve( size_ + s.size() );
+			std::memcpy( data_ + size_, s.data(), s.size() );
+			size_ += s.size();
+			data_[ size_ ] = '\0';
+			return *this;
+		}
+		basic_string_builder& append( size_t count, char c ) {
+			reserve( size_ + count );
+			std::memset( data_ + size_, c, count );
+			size_ += count;
+			data_[ size_ ] = '\0';
+			return *this;
+		}
+		basic_string_builder& operator+=( std::string_view s ) { return append( s ); }
+		basic_string_builder& operator+=( char c ) { push_back( c ); return *this; }
+		void push_back( char c ) { reserve( size_ + 1 ); data_[ size_++ ] = c; data_[ size_ ] = '\0'; }
+
+		/// append formatted string (printf style)
+		basic_string_builder& appendf( const char* format, ... ) {
+			va_list args;
+			va_start( args, format );
+			vappendf( format, args );
+			va_end( args );
+			return *this;
+		}
+
+		/// append formatted string using va_list
+		basic_string_builder& vappendf( const char* format, va_list args ) {
+			va_list args_copy;
+			va_copy( args_copy, args );
+			int n = std::vsnprintf( data_ + size_, capacity_ + 1 - size_, format, args_copy );
+			va_end( args_copy );
+			if ( n > 0 && size_ + n > capacity_ ) {
+				// output was truncated, grow and format again
+				reserve( size_ + n );
+				std::vsnprintf( data_ + size_, capacity_ + 1 - size_, format, args );
+			}
+			if ( n > 0 ) size_ += n;
+			return *this;
+		}
+
+		void reserve( size_t n ) {
+			if ( n > capacity_ ) {
+				auto new_capacity = n > 2 * capacity_ ? n : 2 * capacity_;
+				auto new_data = std::make_unique< char[] >( new_capacity + 1 );
+				std::memcpy( new_data.get(), data_, size_ + 1 );
+				heap_ = std::move( new_data );
+				data_ = heap_.get();
+				capacity_ = new_capacity;
+			}
+		}
+		void resize( size_t n ) { if ( n > size_ ) append( n - size_, '\0' ); else { size_ = n; data_[ size_ ] = '\0'; } }
+		void clear() { resize( 0 ); }
+
+		const char* c_str() const { return data_; }
+		const char* data() const { return data_; }
+		size_t size() const { return size_; }
+		bool empty() const { return size_ == 0; }
+		size_t capacity() const { return capacity_; }
+		bool is_inline() const { return data_ == buffer_; }
+
+		std::string_view view() const { return std::string_view( data_, size_ ); }
+		operator std::string_view() const { return view(); }
+		std::string str() const { return std::string( data_, size_ ); }
+
+		char& operator[]( size_t i ) { return data_[ i ]; }
+		char operator[]( size_t i ) const { return data_[ i ]; }
+		const char* begin() const { return data_; }
+		const char* end() const { return data_ + size_; }
+
+	private:
+		char* data_;
+		size_t size_;
+		size_t capacity_; // excluding terminating zero
+		std::unique_ptr< char[] > heap_;
+		char buffer_[ N + 1 ];
+	};
+
+	template< size_t N > bool operator==( const basic_string_builder< N >& a, std::string_view b ) { return a.view() == b; }
+	template< size_t N > bool operator!=( const basic_string_builder< N >& a, std::string_view b ) { return a.view() != b; }
+
+	/// string builder with 256 bytes of inline storage
+	using string_builder = basic_string_builder< 256 >;
+}
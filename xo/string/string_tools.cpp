@@ -19,6 +19,7 @@
 #include <cctype>
 
 #include "xo/system/error_code.h"
+#include "xo/string/string_builder.h"
 #include "xo/numerical/math.h"
 #include "xo/system/assert.h"
 
@@ -163,19 +164,12 @@ namespace xo
 
 	string stringf( const char* format, ... )
 	{
-#ifdef XO_COMP_MSVC
-#	pragma warning( push )
-#	pragma warning( disable: 4996 )
-#endif
 		va_list args;
 		va_start( args, format );
-		char buf[256];
-		vsnprintf( buf, sizeof( buf ), format, args );
+		string_builder buf;
+		buf.vappendf( format, args );
 		va_end( args );
-		return string( buf );
-#ifdef XO_COMP_MSVC
-#	pragma warning( pop )
-#endif
+		return buf.str();
 	}
 
 	bool str_equals_any_of( const string& str, std::initializer_list< const char* > str_list )
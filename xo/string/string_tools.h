@@ -5,8 +5,11 @@
 #include "xo/container/vector_type.h"
 #include "xo/container/pair_type.h"
 #include "xo/string/string_cast.h"
+#include "xo/utility/sfinae_tools.h"
 
 #include <initializer_list>
+#include <iterator>
+#include <string_view>
 
 #define xo_varstr( var_ ) ( ::std::string( #var_ ) + '=' + ::xo::to_str( ( var_ ) ) )
 
@@ -113,4 +116,109 @@ namespace xo
 		}
 		return str;
 	}
+
+	/// lazy range of substrings separated by any of sep_chars, empty substrings are skipped
+	class str_split_range
+	{
+	public:
+		class iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = std::string_view;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const std::string_view*;
+			using reference = const std::string_view&;
+
+			iterator( std::string_view str, std::string_view sep_chars, size_t pos ) : str_( str ), sep_( sep_chars ), pos_( pos ) { update(); }
+			reference operator*() const { return cur_; }
+			pointer operator->() const { return &cur_; }
+			iterator& operator++() { pos_ = str_.find_first_not_of( sep_, pos_ + cur_.size() ); update(); return *this; }
+			iterator operator++( int ) { auto tmp = *this; ++*this; return tmp; }
+			bool operator==( const iterator& other ) const { return pos_ == other.pos_; }
+			bool operator!=( const iterator& other ) const { return pos_ != other.pos_; }
+
+		private:
+			void update() {
+				if ( pos_ != std::string_view::npos )
+					cur_ = str_.substr( pos_, str_.find_first_of( sep_, pos_ ) - pos_ );
+			}
+			std::string_view str_;
+			std::string_view sep_;
+			size_t pos_;
+			std::string_view cur_;
+		};
+
+		str_split_range( std::string_view str, std::string_view sep_chars ) : str_( str ), sep_( sep_chars ) {}
+		iterator begin() const { return iterator( str_, sep_, str_.find_first_not_of( sep_ ) ); }
+		iterator end() const { return iterator( str_, sep_, std::string_view::npos ); }
+
+	private:
+		std::string_view str_;
+		std::string_view sep_;
+	};
+
+	/// split a string without allocating, returns a range of views into str
+	inline str_split_range split_str_range( std::string_view str, std::string_view sep_chars ) { return str_split_range( str, sep_chars ); }
+
+	/// get left n characters as view; if n is negative, get view WITHOUT the right n characters
+	template< typename T, XO_ENABLE_IF_STRING_VIEW > std::string_view left_str( T str, int n ) {
+		return str.substr( 0, n >= 0 ? size_t( n ) : size_t( int( str.size() ) + n > 0 ? int( str.size() ) + n : 0 ) );
+	}
+
+	/// get middle n characters as view, starting from pos
+	template< typename T, XO_ENABLE_IF_STRING_VIEW > std::string_view mid_str( T str, index_t pos, size_t n = std::string_view::npos ) {
+		return str.substr( pos, n );
+	}
+
+	/// get right n characters as view; if n is negative, get view WITHOUT the left n characters
+	template< typename T, XO_ENABLE_IF_STRING_VIEW > std::string_view right_str( T str, int n ) {
+		return str.substr( n >= 0 ? str.size() - n : size_t( -n ) );
+	}
+
+	/// remove leading and trailing characters, returns view
+	template< typename T, XO_ENABLE_IF_STRING_VIEW > std::string_view trim_str( T str, const char* trim_chars = " \t\r\n\f\v" ) {
+		auto left = str.find_first_not_of( trim_chars );
+		if ( left == std::string_view::npos ) return std::string_view();
+		return str.substr( left, 1 + str.find_last_not_of( trim_chars ) - left );
+	}
+
+	/// remove leading characters, returns view
+	template< typename T, XO_ENABLE_IF_STRING_VIEW > std::string_view trim_left_str( T str, const char* trim_chars = " \t\r\n\f\v" ) {
+		auto left = str.find_first_not_of( trim_chars );
+		return left != std::string_view::npos ? str.substr( left ) : std::string_view();
+	}
+
+	/// remove trailing characters, returns view
+	template< typename T, XO_ENABLE_IF_STRING_VIEW > std::string_view trim_right_str( T str, const char* trim_chars = " \t\r\n\f\v" ) {
+		return str.substr( 0, 1 + str.find_last_not_of( trim_chars ) );
+	}
+
+	/// split a string into a vector of views
+	template< typename T, XO_ENABLE_IF_STRING_VIEW > vector< std::string_view > split_str( T str, std::string_view sep_chars ) {
+		auto r = split_str_range( str, sep_chars );
+		return vector< std::string_view >( r.begin(), r.end() );
+	}
+
+	/// split view into pair at first occurrence of sep_char, second is empty if not occurring
+	template< typename T, XO_ENABLE_IF_STRING_VIEW > std::pair< std::string_view, std::string_view > split_str_at_first( T str, std::string_view sep_chars ) {
+		if ( auto pos = str.find_first_of( sep_chars ); pos != std::string_view::npos )
+			return { str.substr( 0, pos ), str.substr( pos + 1 ) };
+		else return { str, std::string_view() };
+	}
+
+	/// split view into pair at last occurrence of sep_char, second is empty if not occurring
+	template< typename T, XO_ENABLE_IF_STRING_VIEW > std::pair< std::string_view, std::string_view > split_str_at_last( T str, std::string_view sep_chars ) {
+		if ( auto pos = str.find_last_of( sep_chars ); pos != std::string_view::npos )
+			return { str.substr( 0, pos ), str.substr( pos + 1 ) };
+		else return { str, std::string_view() };
+	}
+
+	/// split view into trimmed key / value pair of views
+	template< typename T, XO_ENABLE_IF_STRING_VIEW > std::pair< std::string_view, std::string_view > make_key_value_str( T str, std::string_view sep_char = "=" ) {
+		auto pos = str.find_first_of( sep_char );
+		if ( pos == std::string_view::npos )
+			return { str, std::string_view() };
+		else return { trim_str( str.substr( 0, pos ) ), trim_str( str.substr( pos + 1 ) ) };
+	}
 }
@@ -13,7 +13,7 @@ namespace xo
 		level global_log_level = level::never;
 		xo::vector< sink* > global_sinks;
 
-		void log_string( level l, const string& str )
+		void log_string( level l, std::string_view str )
 		{
 			// no need to do additional test_log_level(), no performance gain
 			for ( auto s : global_sinks )
@@ -24,9 +24,9 @@ namespace xo
 		{
 			if ( test_log_level( l ) ) // check for global log level first
 			{
-				char buf[ 1024 ];
-				vsnprintf( buf, sizeof( buf ), format, list );
-				log_string( l, string( buf ) ); // #todo: use string_view
+				string_builder s;
+				s.vappendf( format, list );
+				log_string( l, s.view() );
 			}
 		}
 
@@ -3,7 +3,11 @@
 #include "xo/system/xo_config.h"
 #include "xo/string/string_type.h"
 #include "xo/string/string_cast.h"
+#include "xo/string/string_builder.h"
 #include "xo/system/log_level.h"
+#include <cstdarg>
+#include <string_view>
+#include <type_traits>
 
 #define xo_logvar( var_ ) xo::log::debug( #var_"=", var_ )
 #define xo_logvar2( var1_, var2_ ) xo::log::debug( #var1_"=", var1_, "\t", #var2_"=", var2_ )
@@ -26,23 +30,25 @@ namespace xo
 		XO_API bool test_log_level( level l );
 
 		// log with specific level
-		XO_API void log_string( level l, const string& s );
+		XO_API void log_string( level l, std::string_view s );
 		XO_API void log_vstring( level l, const char* format, va_list list );
 
 		// flush all sinks, happens automatically if level >= level::error
 		XO_API void flush();
 
-		template< typename T, typename... Args > void log_string( level l, std::string& s, T v, const Args&... args ) {
-			s += to_str( v );
-			log_string( l, s, args... );
+		/// append value to a log message, strings are appended without conversion
+		template< typename T > void append_log_value( string_builder& s, const T& v ) {
+			if constexpr ( std::is_convertible_v< const T&, std::string_view > )
+				s += std::string_view( v );
+			else s += to_str( v );
 		}
 
-		// log at specified level
+		// log at specified level, formatted into inline storage
 		template< typename... Args > void message( level l, const Args&... args ) {
 			if ( test_log_level( l ) ) {
-				std::string s;
-				s.reserve( 256 );
-				log_string( l, s, args... );
+				string_builder s;
+				( append_log_value( s, args ), ... );
+				log_string( l, s.view() );
 			}
 		}
 		void messagef( level l, const char* format, ... );
@@ -37,12 +37,17 @@ namespace xo
 			else return l >= log_level_ && ( std::this_thread::get_id() == thread_id_ );
 		}
 
-		void sink::submit_log_message( level l, const string& msg )
+		void sink::submit_log_message( level l, std::string_view msg )
 		{
 			if ( test_log_level( l ) )
 				hande_log_message( l, msg );
 		}
 
+		void sink::hande_log_message( level l, std::string_view msg )
+		{
+			hande_log_message( l, string( msg ) );
+		}
+
 		void sink::set_log_level( level l )
 		{
 			log_level_ = l;
@@ -64,7 +69,7 @@ namespace xo
 			stream_( str )
 		{}
 
-		void stream_sink::hande_log_message( level l, const string& msg )
+		void stream_sink::hande_log_message( level l, std::string_view msg )
 		{
 			// #todo: make the time prefix an option
 			auto str = get_date_time_str( "%H:%M:%S " );
@@ -80,7 +85,7 @@ namespace xo
 			stream_sink( std::cout, l, m )
 		{}
 
-		void console_sink::hande_log_message( level l, const string& msg )
+		void console_sink::hande_log_message( level l, std::string_view msg )
 		{
 			auto str = get_date_time_str( "%H:%M:%S " );
 
@@ -100,7 +105,7 @@ namespace xo
 				SetConsoleTextAttribute( h, FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE | bg );
 				break;
 			case xo::log::level::info:
-				if ( xo::str_begins_with( msg, "Success" ) ) // make green if message starts with 'Success', ha ha
+				if ( msg.substr( 0, 7 ) == "Success" ) // make green if message starts with 'Success', ha ha
 					SetConsoleTextAttribute( h, FOREGROUND_GREEN | FOREGROUND_INTENSITY | bg );
 				else // normal boring white if not
 					SetConsoleTextAttribute( h, FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE | FOREGROUND_INTENSITY | bg );
@@ -132,7 +137,7 @@ namespace xo
 			file_stream_.open( file.str() );
 		}
 
-		void file_sink::hande_log_message( level l, const string& msg )
+		void file_sink::hande_log_message( level l, std::string_view msg )
 		{
 			if ( file_stream_.good() )
 				stream_sink::hande_log_message( l, msg );
@@ -5,6 +5,7 @@
 #include "xo/filesystem/path.h"
 
 #include <fstream>
+#include <string_view>
 #include <thread>
 
 namespace xo
@@ -23,7 +24,11 @@ namespace xo
 			virtual bool test_log_level( level l ) const;
 
 			/// calls hande_log_message( l, msg ) if test_log_level( l ) == true
-			virtual void submit_log_message( level l, const string& msg );
+			virtual void submit_log_message( level l, std::string_view msg );
+
+			/// deprecated, forwards to submit_log_message( level, std::string_view ), which is called by log_string()
+			virtual void submit_log_message( level l, const string& msg ) { submit_log_message( l, std::string_view( msg ) ); }
+			void submit_log_message( level l, const char* msg ) { submit_log_message( l, std::string_view( msg ) ); }
 
 			/// flush log messages
 			virtual void flush() {}
@@ -40,6 +45,10 @@ namespace xo
 			sink_mode sink_mode_;
 			std::thread::id thread_id_;
 
+			/// handle log message without testing, forwards to hande_log_message( level, const string& ) unless
+			/// overridden; sinks that override it avoid creating a string for each message
+			virtual void hande_log_message( level l, std::string_view msg );
+
 			/// handle log message without testing
 			virtual void hande_log_message( level l, const string& msg ) = 0;
 		};
@@ -48,7 +57,8 @@ namespace xo
 		{
 		public:
 			stream_sink( std::ostream& str, level l, sink_mode m = sink_mode::all_threads );
-			virtual void hande_log_message( level l, const string& msg ) override;
+			virtual void hande_log_message( level l, std::string_view msg ) override;
+			virtual void hande_log_message( level l, const string& msg ) override { hande_log_message( l, std::string_view( msg ) ); }
 			virtual void flush() override;
 
 		protected:
@@ -59,14 +69,16 @@ namespace xo
 		{
 		public:
 			console_sink( level l, sink_mode m = sink_mode::all_threads );
-			virtual void hande_log_message( level l, const string& msg ) override;
+			virtual void hande_log_message( level l, std::string_view msg ) override;
+			virtual void hande_log_message( level l, const string& msg ) override { hande_log_message( l, std::string_view( msg ) ); }
 		};
 
 		class XO_API file_sink : public stream_sink
 		{
 		public:
 			file_sink( const path& file, level l, sink_mode m = sink_mode::all_threads );
-			virtual void hande_log_message( level l, const string& msg ) override;
+			virtual void hande_log_message( level l, std::string_view msg ) override;
+			virtual void hande_log_message( level l, const string& msg ) override { hande_log_message( l, std::string_view( msg ) ); }
 			const std::ofstream& file_stream() const { return file_stream_; }
 
 		protected:
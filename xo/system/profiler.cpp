@@ -6,6 +6,8 @@
 #include "xo/numerical/math.h"
 #include "xo/container/prop_node.h"
 #include "xo/string/string_tools.h"
+#include "xo/string/fixed_string.h"
+#include "xo/string/string_builder.h"
 #include "xo/container/prop_node_tools.h"
 
 namespace xo
@@ -115,9 +117,9 @@ namespace xo
 		else return add_section( name, parent_id );
 	}
 
-	std::vector< profiler::section* > profiler::get_children( size_t parent_id )
+	small_vector< profiler::section*, 16 > profiler::get_children( size_t parent_id )
 	{
-		std::vector< profiler::section* > children;
+		small_vector< profiler::section*, 16 > children;
 		for ( auto& s : sections_ )
 			if ( s.parent_id == parent_id ) children.push_back( &s );
 		return children;
@@ -144,7 +146,7 @@ namespace xo
 		double over = total_overhead( s ).milliseconds();
 		double over_perc = 100.0 * over / total_ms;
 
-		string key;
+		string_builder key;
 		if ( add_log_level_tag )
 		{
 			if ( excl_perc < 1 ) key += "@2";
@@ -152,9 +154,11 @@ namespace xo
 			else if ( excl_perc < 15 ) key += "@4";
 			else key += "@5";
 		}
+		key += s->name;
 
-		auto value = stringf( "%6.0fms %6.2f%% (%5.2f%%) %6d %6.0fns ~%2.0f%% OH", total_ms, total_perc, excl_perc, s->count, excl_avg_ns, clamped( over_perc, 0.0, 99.0 ) );
-		auto& child_pn = pn.add_key_value( key + s->name, value );
+		fixed_string< 64 > value;
+		value.appendf( "%6.0fms %6.2f%% (%5.2f%%) %6d %6.0fns ~%2.0f%% OH", total_ms, total_perc, excl_perc, s->count, excl_avg_ns, clamped( over_perc, 0.0, 99.0 ) );
+		auto& child_pn = pn.add_key_value( key.str(), value.str() );
 		if ( total_perc >= minimum_expand_percentage )
 		{
 			auto children = get_children( s->id );
@@ -3,6 +3,7 @@
 #include "xo/xo_types.h"
 #include "xo/system/system_tools.h"
 #include "xo/time/timer.h"
+#include "xo/container/small_vector.h"
 #include <thread>
 #include <vector>
 
@@ -52,7 +53,7 @@ namespace xo
 		section* find_section( const char* name, size_t parent_id );
 		section* acquire_section( const char* name, size_t parent_id );
 		section* add_section( const char* name, size_t parent_id );
-		std::vector< section* > get_children( size_t parent_id );
+		small_vector< section*, 16 > get_children( size_t parent_id );
 
 	private:
 		std::vector< section > sections_;
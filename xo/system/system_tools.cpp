@@ -8,6 +8,7 @@
 #	pragma warning( disable: 4996 )
 #else
 #   include <cxxabi.h>
+#   include <sys/mman.h>
 #endif
 
 #include "xo/string/string_tools.h"
@@ -21,6 +22,7 @@
 #include <sys/stat.h>
 #include <iomanip>
 #include <sstream>
+#include <new>
 #include "assert.h"
 
 namespace xo
@@ -101,6 +103,40 @@ namespace xo
 		else return buf;
 #else
 		return string( "" );
+#endif
+	}
+
+	XO_API void* allocate_huge_pages( size_t bytes )
+	{
+#ifdef XO_COMP_MSVC
+		// large pages require SeLockMemoryPrivilege, fall back to regular pages if they fail
+		if ( auto large_page = GetLargePageMinimum(); large_page > 0 && bytes >= large_page ) {
+			auto large_bytes = ( bytes + large_page - 1 ) / large_page * large_page;
+			if ( auto* p = VirtualAlloc( nullptr, large_bytes, MEM_COMMIT | MEM_RESERVE | MEM_LARGE_PAGES, PAGE_READWRITE ) )
+				return p;
+		}
+		auto* p = VirtualAlloc( nullptr, bytes, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE );
+		if ( !p ) throw std::bad_alloc();
+		return p;
+#else
+		auto* p = mmap( nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+		if ( p == MAP_FAILED ) throw std::bad_alloc();
+#	ifdef MADV_HUGEPAGE
+		if ( bytes >= ( size_t( 2 ) << 20 ) )
+			madvise( p, bytes, MADV_HUGEPAGE );
+#	endif
+		return p;
+#endif
+	}
+
+	XO_API void free_huge_pages( void* p, size_t bytes )
+	{
+		if ( !p )
+			return;
+#ifdef XO_COMP_MSVC
+		VirtualFree( p, 0, MEM_RELEASE );
+#else
+		munmap( p, bytes );
 #endif
 	}
 }
@@ -14,6 +14,12 @@ namespace xo
 	XO_API string tidy_identifier( const string& id );
 	XO_API string tidy_type_name( const string& name );
 	XO_API string get_computer_name();
+
+	/// allocate page-aligned memory, using transparent huge pages or large pages when available
+	XO_API void* allocate_huge_pages( size_t bytes );
+	/// free memory allocated with allocate_huge_pages, bytes must match the allocated size
+	XO_API void free_huge_pages( void* p, size_t bytes );
+
 	template< typename T > string get_type_name() { return string( typeid( T ).name() ); }
 	template< typename T > string get_clean_type_name() { return tidy_type_name( get_type_name<T>() ); }
 	template< typename T > string get_type_name( const T& obj ) { return string( typeid( obj ).name() ); }
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "xo/xo_types.h"
+#include "xo/system/assert.h"
+#include "xo/numerical/math.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace xo
+{
+	/// size of a cache line, used to keep producer and consumer data apart
+	constexpr size_t cache_line_size = 64;
+
+	/// lock-free fixed-capacity ring buffer for a single producer thread and a single consumer thread
+	/// capacity is rounded up to a power of two, T must be default constructible
+	template< typename T >
+	class spsc_ring
+	{
+	public:
+		using value_type = T;
+
+		explicit spsc_ring( size_t capacity ) :
+			mask_( ceil_power_of_two( capacity ) - 1 ),
+			buffer_( new T[ mask_ + 1 ] ),
+			head_( 0 ), tail_( 0 ), cached_tail_( 0 ), cached_head_( 0 ) {}
+		spsc_ring( const spsc_ring& ) = delete;
+		spsc_ring& operator=( const spsc_ring& ) = delete;
+
+		/// add value, returns false if the ring is full (producer only)
+		bool try_push( const T& value ) { return emplace_impl( value ); }
+		bool try_push( T&& value ) { return emplace_impl( std::move( value ) ); }
+
+		/// add up to n values, returns number of values added (producer only)
+		size_t try_push( const T* values, size_t n ) {
+			const auto tail = tail_.load( std::memory_order_relaxed );
+			if ( n > capacity() - ( tail - cached_head_ ) )
+				cached_head_ = head_.load( std::memory_order_acquire );
+			n = std::min( n, capacity() - ( tail - cached_head_ ) );
+			for ( size_t i = 0; i < n; ++i )
+				buffer_[ ( tail + i ) & mask_ ] = values[ i ];
+			tail_.store( tail + n, std::memory_order_release );
+			return n;
+		}
+
+		/// get value, returns false if the ring is empty (consumer only)
+		bool try_pop( T& value ) {
+			const auto head = head_.load( std::memory_order_relaxed );
+			if ( head == cached_tail_ && head == ( cached_tail_ = tail_.load( std::memory_order_acquire ) ) )
+				return false;
+			value = std::move( buffer_[ head & mask_ ] );
+			head_.store( head + 1, std::memory_order_release );
+			return true;
+		}
+
+		/// get up to n values, returns number of values read (consumer only)
+		size_t try_pop( T* values, size_t n ) {
+			const auto head = head_.load( std::memory_order_relaxed );
+			if ( n > cached_tail_ - head )
+				cached_tail_ = tail_.load( std::memory_order_acquire );
+			n = std::min( n, cached_tail_ - head );
+			for ( size_t i = 0; i < n; ++i )
+				values[ i ] = std::move( buffer_[ ( head + i ) & mask_ ] );
+			head_.store( head + n, std::memory_order_release );
+			return n;
+		}
+
+		/// number of values in the ring, only exact when called from the producer or consumer thread
+		size_t size() const { return tail_.load( std::memory_order_acquire ) - head_.load( std::memory_order_acquire ); }
+		bool empty() const { return size() == 0; }
+		size_t capacity() const { return mask_ + 1; }
+
+	private:
+		template< typename V > bool emplace_impl( V&& value ) {
+			const auto tail = tail_.load( std::memory_order_relaxed );
+			if ( tail - cached_head_ == capacity() && tail - ( cached_head_ = head_.load( std::memory_order_acquire ) ) == capacity() )
+				return false;
+			buffer_[ tail & mask_ ] = std::forward< V >( value );
+			tail_.store( tail + 1, std::memory_order_release );
+			return true;
+		}
+
+		const size_t mask_;
+		const std::unique_ptr< T[] > buffer_;
+
+		// consumer and producer positions are on separate cache lines to prevent false sharing
+		alignas( cache_line_size ) std::atomic< size_t > head_;
+		alignas( cache_line_size ) std::atomic< size_t > tail_;
+		alignas( cache_line_size ) size_t cached_tail_; // consumer copy of tail_
+		alignas( cache_line_size ) size_t cached_head_; // producer copy of head_
+	};
+
+	/// lock-free bounded ring buffer for multiple producer and consumer threads
+	/// capacity is rounded up to a power of two, T must be default constructible
+	template< typename T >
+	class mpmc_ring
+	{
+	public:
+		using value_type = T;
+
+		explicit mpmc_ring( size_t capacity ) :
+			mask_( ceil_power_of_two( std::max< size_t >( capacity, 2 ) ) - 1 ),
+			cells_( new cell[ mask_ + 1 ] ),
+			head_( 0 ), tail_( 0 ) {
+			for ( size_t i = 0; i <= mask_; ++i )
+				cells_[ i ].sequence.store( i, std::memory_order_relaxed );
+		}
+		mpmc_ring( const mpmc_ring& ) = delete;
+		mpmc_ring& operator=( const mpmc_ring& ) = delete;
+
+		/// add value, returns false if the ring is full
+		bool try_push( const T& value ) { return emplace_impl( value ); }
+		bool try_push( T&& value ) { return emplace_impl( std::move( value ) ); }
+
+		/// get value, returns false if the ring is empty
+		bool try_pop( T& value ) {
+			auto pos = head_.load( std::memory_order_relaxed );
+			for ( ;; ) {
+				auto& c = cells_[ pos & mask_ ];
+				auto seq = c.sequence.load( std::memory_order_acquire );
+				auto diff = static_cast<std::ptrdiff_t>( seq ) - static_cast<std::ptrdiff_t>( pos + 1 );
+				if ( diff == 0 ) {
+					if ( head_.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) ) {
+						value = std::move( c.value );
+						c.sequence.store( pos + mask_ + 1, std::memory_order_release );
+						return true;
+					}
+				}
+				else if ( diff < 0 )
+					return false; // empty
+				else pos = head_.load( std::memory_order_relaxed );
+			}
+		}
+
+		/// approximate number of values in the ring
+		size_t size() const {
+			auto t = tail_.load( std::memory_order_acquire ), h = head_.load( std::memory_order_acquire );
+			return t > h ? t - h : 0;
+		}
+		bool empty() const { return size() == 0; }
+		size_t capacity() const { return mask_ + 1; }
+
+	private:
+		// each cell has a sequence number that indicates if it is ready for writing or reading
+		struct cell {
+			std::atomic< size_t > sequence;
+			T value;
+		};
+
+		template< typename V > bool emplace_impl( V&& value ) {
+			auto pos = tail_.load( std::memory_order_relaxed );
+			for ( ;; ) {
+				auto& c = cells_[ pos & mask_ ];
+				auto seq = c.sequence.load( std::memory_order_acquire );
+				auto diff = static_cast<std::ptrdiff_t>( seq ) - static_cast<std::ptrdiff_t>( pos );
+				if ( diff == 0 ) {
+					if ( tail_.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) ) {
+						c.value = std::forward< V >( value );
+						c.sequence.store( pos + 1, std::memory_order_release );
+						return true;
+					}
+				}
+				else if ( diff < 0 )
+					return false; // full
+				else pos = tail_.load( std::memory_order_relaxed );
+			}
+		}
+
+		const size_t mask_;
+		const std::unique_ptr< cell[] > cells_;
+		alignas( cache_line_size ) std::atomic< size_t > head_;
+		alignas( cache_line_size ) std::atomic< size_t > tail_;
+	};
+}
@@ -0,0 +1,101 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
+namespace xo
+{
+	thread_pool::thread_pool( size_t num_threads ) : stop_( false )
+	{
+		for ( size_t i = 0; i < num_threads; ++i )
+			threads_.emplace_back( [this]() { worker(); } );
+	}
+
+	thread_pool::~thread_pool()
+	{
+		{
+			std::scoped_lock lock( mutex_ );
+			stop_ = true;
+		}
+		condition_.notify_all();
+		for ( auto& t : threads_ )
+			t.join();
+	}
+
+	void thread_pool::worker()
+	{
+		for ( ;; )
+		{
+			std::function< void() > task;
+			{
+				std::unique_lock lock( mutex_ );
+				condition_.wait( lock, [this]() { return stop_ || !tasks_.empty(); } );
+				if ( tasks_.empty() )
+					return; // stop_ was set and all tasks are done
+				task = std::move( tasks_.front() );
+				tasks_.pop_front();
+			}
+			task();
+		}
+	}
+
+	bool thread_pool::run_pending_task()
+	{
+		std::function< void() > task;
+		{
+			std::scoped_lock lock( mutex_ );
+			if ( tasks_.empty() )
+				return false;
+			task = std::move( tasks_.front() );
+			tasks_.pop_front();
+		}
+		task();
+		return true;
+	}
+
+	void thread_pool::parallel_for( size_t begin, size_t end, const std::function< void( size_t, size_t ) >& f, size_t min_block_size )
+	{
+		if ( end <= begin )
+			return;
+		size_t n = end - begin;
+		size_t num_blocks = std::min( threads_.size() + 1, std::max< size_t >( 1, n / std::max< size_t >( 1, min_block_size ) ) );
+		if ( num_blocks == 1 )
+			return f( begin, end );
+
+		// submit all blocks but the first, which is run on the calling thread
+		std::vector< std::future< void > > futures;
+		futures.reserve( num_blocks - 1 );
+		std::exception_ptr error;
+		try
+		{
+			for ( size_t i = 1; i < num_blocks; ++i )
+			{
+				size_t b = begin + n * i / num_blocks;
+				size_t e = begin + n * ( i + 1 ) / num_blocks;
+				futures.push_back( submit( [&f, b, e]() { f( b, e ); } ) );
+			}
+			f( begin, begin + n / num_blocks );
+		}
+		catch ( ... ) { error = std::current_exception(); }
+
+		// all blocks must finish before returning, because they refer to f
+		// queued tasks are run while waiting, so that nested calls from worker threads cannot deadlock
+		for ( auto& fut : futures )
+		{
+			while ( fut.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready )
+				if ( !run_pending_task() )
+					fut.wait();
+			try { fut.get(); }
+			catch ( ... ) { if ( !error ) error = std::current_exception(); }
+		}
+		if ( error )
+			std::rethrow_exception( error );
+	}
+
+	thread_pool& global_thread_pool()
+	{
+		static thread_pool pool;
+		return pool;
+	}
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "xo/system/xo_config.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace xo
+{
+	/// fixed-size pool of worker threads
+	class XO_API thread_pool
+	{
+	public:
+		/// create pool with num_threads workers, the calling thread also participates in parallel_for
+		explicit thread_pool( size_t num_threads = std::max( 1u, std::thread::hardware_concurrency() ) - 1 );
+		~thread_pool();
+		thread_pool( const thread_pool& ) = delete;
+		thread_pool& operator=( const thread_pool& ) = delete;
+
+		/// run task on a worker thread
+		template< typename F > std::future< void > submit( F task ) {
+			auto pt = std::make_shared< std::packaged_task< void() > >( std::move( task ) );
+			auto fut = pt->get_future();
+			if ( threads_.empty() )
+				( *pt )();
+			else {
+				std::scoped_lock lock( mutex_ );
+				tasks_.emplace_back( [pt]() { ( *pt )(); } );
+				condition_.notify_one();
+			}
+			return fut;
+		}
+
+		/// call f( b, e ) for consecutive blocks [b, e) in [begin, end), using all threads
+		/// blocks contain at least min_block_size elements, exceptions are rethrown in the calling thread after all blocks
+		/// are done. While waiting, the calling thread runs queued tasks, so parallel_for can be called from within a task
+		void parallel_for( size_t begin, size_t end, const std::function< void( size_t, size_t ) >& f, size_t min_block_size = 1 );
+
+		/// number of worker threads
+		size_t size() const { return threads_.size(); }
+
+	private:
+		void worker();
+		bool run_pending_task();
+
+		std::vector< std::thread > threads_;
+		std::deque< std::function< void() > > tasks_;
+		std::mutex mutex_;
+		std::condition_variable condition_;
+		bool stop_;
+	};
+
+	/// thread pool shared by xo algorithms, created on first use
+	XO_API thread_pool& global_thread_pool();
+}
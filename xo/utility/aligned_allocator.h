@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace xo
+{
+	/// allocator that aligns memory to Alignment bytes, e.g. for SIMD access or to avoid sharing cache lines
+	template< typename T, size_t Alignment = 64 >
+	struct aligned_allocator
+	{
+		static_assert( Alignment >= alignof( T ) && ( Alignment & ( Alignment - 1 ) ) == 0, "Alignment must be a power of two" );
+		using value_type = T;
+		template< typename U > struct rebind { using other = aligned_allocator< U, Alignment >; };
+
+		aligned_allocator() noexcept = default;
+		template< typename U > aligned_allocator( const aligned_allocator< U, Alignment >& ) noexcept {}
+
+		T* allocate( size_t n ) { return static_cast<T*>( ::operator new( n * sizeof( T ), std::align_val_t( Alignment ) ) ); }
+		void deallocate( T* p, size_t ) noexcept { ::operator delete( p, std::align_val_t( Alignment ) ); }
+
+		template< typename U > bool operator==( const aligned_allocator< U, Alignment >& ) const noexcept { return true; }
+		template< typename U > bool operator!=( const aligned_allocator< U, Alignment >& ) const noexcept { return false; }
+	};
+}
@@ -2,7 +2,7 @@
 
 #include "color.h"
 #include "xo/container/pair_type.h"
-#include "xo/container/flat_map.h"
+#include "xo/container/eytzinger_map.h"
 #include "xo/numerical/interpolation.h"
 
 #include <initializer_list>
@@ -15,6 +15,6 @@ namespace xo
 		color operator()( float v ) {
 			return lerp_map( colors_, v );
 		}
-		flat_map< float, color > colors_;
+		eytzinger_map< float, color > colors_;
 	};
 }
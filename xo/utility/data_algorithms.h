@@ -2,6 +2,7 @@
 
 #include "xo/container/table.h"
 #include "xo/container/storage.h"
+#include "xo/container/column_storage.h"
 #include <vector>
 
 namespace xo
@@ -20,6 +21,22 @@ namespace xo
 		return means;
 	}
 
+	template< typename T, typename L >
+	std::vector< T > compute_channel_means( const column_storage< T, L >& sto )
+	{
+		// channels are contiguous, which allows the compiler to vectorize the inner loop
+		std::vector< T > means( sto.channel_size() );
+		for ( index_t col = 0; col < sto.channel_size(); ++col )
+		{
+			const T* data = sto.channel_data( col );
+			T sum = T( 0 );
+			for ( index_t row = 0; row < sto.frame_size(); ++row )
+				sum += data[ row ];
+			means[ col ] = sum / sto.frame_size();
+		}
+		return means;
+	}
+
 	template< typename T, typename L >
 	table< T > compute_covariance( const storage< T, L >& sto )
 	{
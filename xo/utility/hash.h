@@ -1,7 +1,12 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include "xo/system/xo_config.h"
 
 #ifdef XO_COMP_MSVC
@@ -25,6 +30,41 @@ namespace xo
 	}
 
 	inline hash_t hash( const std::string& str ) { return hash( str.c_str() ); }
+
+	inline hash_t hash( std::string_view str ) {
+		hash_t ret = fnv1a_64_basis;
+		for ( char c : str ) { ret ^= c; ret *= fnv1a_64_prime; }
+		return ret;
+	}
+
+	/// mix the bits of a hash value, so that the low bits can be used directly as table index
+	constexpr hash_t hash_mix( hash_t h ) {
+		h ^= h >> 33; h *= 0xFF51AFD7ED558CCDull;
+		h ^= h >> 33; h *= 0xC4CEB9FE1A85EC53ull;
+		return h ^ ( h >> 33 );
+	}
+
+	/// combine hash value h into seed
+	constexpr hash_t hash_combine( hash_t seed, hash_t h ) { return seed ^ ( h + 0x9E3779B97F4A7C15ull + ( seed << 6 ) + ( seed >> 2 ) ); }
+
+	template< typename T > struct is_tuple_like : std::false_type {};
+	template< typename... T > struct is_tuple_like< std::tuple< T... > > : std::true_type {};
+	template< typename T1, typename T2 > struct is_tuple_like< std::pair< T1, T2 > > : std::true_type {};
+
+	/// hash function object for hash_map, strings can be looked up using string_view or const char*
+	/// tuples and pairs combine the hashes of their elements, other types use std::hash
+	struct hash_fn
+	{
+		using is_transparent = void;
+		hash_t operator()( std::string_view s ) const { return hash( s ); }
+		hash_t operator()( const std::string& s ) const { return hash( std::string_view( s ) ); }
+		hash_t operator()( const char* s ) const { return hash( std::string_view( s ) ); }
+		template< typename T > hash_t operator()( const T& v ) const {
+			if constexpr ( is_tuple_like< T >::value )
+				return std::apply( [this]( const auto&... e ) { hash_t h = 0; ( ( h = hash_combine( h, ( *this )( e ) ) ), ... ); return h; }, v );
+			else return hash_mix( static_cast<hash_t>( std::hash< T >()( v ) ) );
+		}
+	};
 }
 
 constexpr unsigned long long operator""_hash( char const* p, size_t ) { return xo::hash_constexpr( p ); }
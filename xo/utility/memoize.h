@@ -1,6 +1,8 @@
 #pragma once
 
+#include "xo/container/hash_map.h"
 #include <functional>
+#include <tuple>
 
 namespace xo
 {
@@ -17,7 +19,7 @@ namespace xo
 			auto it = mem_.find( tup );
 			if ( it == mem_.end() ) {
 				auto r = func_( args... );
-				mem_[ tup ] = r;
+				mem_.try_emplace( std::move( tup ), r );
 				return r;
 			}
 			else
@@ -25,7 +27,7 @@ namespace xo
 		}
 		
 	private:
-		std::map< std::tuple< Args... >, R > mem_;
+		hash_map< std::tuple< Args... >, R > mem_;
 		std::function< R( Args... ) > func_;
 	};
 }
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "xo/xo_types.h"
+#include "xo/system/assert.h"
+#include "xo/utility/hash.h"
+#include <array>
+#include <string_view>
+
+namespace xo
+{
+	/// seeded fnv1a hash, used for finding perfect hash functions
+	constexpr hash_t hash_seeded( std::string_view str, hash_t seed ) {
+		hash_t h = fnv1a_64_basis ^ ( seed * 0x9E3779B97F4A7C15ull );
+		for ( char c : str ) { h ^= hash_t( c ); h *= fnv1a_64_prime; }
+		return h ^ ( h >> 29 );
+	}
+
+	/// smallest power of two that is at least twice n
+	constexpr size_t perfect_hash_table_size( size_t n ) {
+		size_t s = 1;
+		while ( s < 2 * n ) s *= 2;
+		return s;
+	}
+
+	/// collision-free hash table for a fixed set of N keys, can be built at compile time
+	/// uses hash-and-displace [Belazzougui et al. 2009]: keys are grouped into buckets by their hash, and each bucket
+	/// gets a displacement that maps its keys to free slots. Buckets are placed largest first, and each displacement
+	/// search is bounded by table_size^2 tries, so construction cost grows roughly linearly with N.
+	template< size_t N >
+	class perfect_hash
+	{
+	public:
+		static constexpr size_t table_size = perfect_hash_table_size( N );
+		static constexpr size_t bucket_count = N / 2 + 1;
+		using key_array_t = std::array< std::string_view, N >;
+
+		constexpr perfect_hash( const key_array_t& keys ) : keys_( keys ), seed_( 0 ), displacements_(), slots_() {
+			for ( ; seed_ < max_seed; ++seed_ )
+				if ( try_seed() )
+					return;
+			xo_error( "Could not build perfect hash, keys must be unique" );
+		}
+
+		/// get index of key, or no_index if not found
+		constexpr index_t find( std::string_view key ) const {
+			if constexpr ( N == 0 )
+				return no_index;
+			else {
+				auto h = hash_seeded( key, seed_ );
+				auto idx = slots_[ slot( h, displacements_[ bucket( h ) ] ) ];
+				return ( idx != no_index && keys_[ idx ] == key ) ? idx : no_index;
+			}
+		}
+
+		constexpr bool contains( std::string_view key ) const { return find( key ) != no_index; }
+		constexpr const std::string_view& key( index_t idx ) const { return keys_[ idx ]; }
+		constexpr const key_array_t& keys() const { return keys_; }
+		constexpr size_t size() const { return N; }
+
+	private:
+		static constexpr hash_t max_seed = 8;
+		static constexpr size_t bucket( hash_t h ) { return size_t( h >> 40 ) % bucket_count; }
+		static constexpr size_t slot( hash_t h, size_t d ) {
+			// slot = h1 + d0 * h2 + d1, with h2 odd so that d0 visits all slots
+			const size_t h1 = size_t( h ), h2 = size_t( h >> 20 ) | 1;
+			return ( h1 + ( d / table_size ) * h2 + d % table_size ) & ( table_size - 1 );
+		}
+
+		constexpr bool try_seed() {
+			std::array< hash_t, N > hashes{};
+			std::array< size_t, bucket_count > bucket_sizes{};
+			size_t max_bucket_size = 0;
+			for ( index_t i = 0; i < N; ++i ) {
+				hashes[ i ] = hash_seeded( keys_[ i ], seed_ );
+				auto bs = ++bucket_sizes[ bucket( hashes[ i ] ) ];
+				max_bucket_size = bs > max_bucket_size ? bs : max_bucket_size;
+			}
+			for ( auto& s : slots_ ) s = no_index;
+			for ( auto& d : displacements_ ) d = 0;
+
+			// place buckets from largest to smallest
+			std::array< index_t, N > members{};
+			for ( size_t size = max_bucket_size; size > 0; --size ) {
+				for ( size_t b = 0; b < bucket_count; ++b ) {
+					if ( bucket_sizes[ b ] != size )
+						continue;
+					size_t m = 0;
+					for ( index_t i = 0; i < N; ++i )
+						if ( bucket( hashes[ i ] ) == b )
+							members[ m++ ] = i;
+					if ( !place_bucket( members, m, hashes, b ) )
+						return false;
+				}
+			}
+			return true;
+		}
+
+		constexpr bool place_bucket( const std::array< index_t, N >& members, size_t m, const std::array< hash_t, N >& hashes, size_t b ) {
+			for ( size_t d = 0; d < table_size * table_size; ++d ) {
+				bool fits = true;
+				for ( size_t i = 0; i < m && fits; ++i ) {
+					auto si = slot( hashes[ members[ i ] ], d );
+					fits = slots_[ si ] == no_index;
+					for ( size_t j = 0; j < i && fits; ++j )
+						fits = slot( hashes[ members[ j ] ], d ) != si;
+				}
+				if ( fits ) {
+					displacements_[ b ] = d;
+					for ( size_t i = 0; i < m; ++i )
+						slots_[ slot( hashes[ members[ i ] ], d ) ] = members[ i ];
+					return true;
+				}
+			}
+			return false;
+		}
+
+		key_array_t keys_;
+		hash_t seed_;
+		std::array< size_t, bucket_count > displacements_;
+		std::array< index_t, table_size > slots_;
+	};
+
+	template< typename... Args >
+	constexpr perfect_hash< sizeof...( Args ) > make_perfect_hash( Args... keys ) {
+		return perfect_hash< sizeof...( Args ) >( { std::string_view( keys )... } );
+	}
+}
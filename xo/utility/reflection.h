@@ -0,0 +1,86 @@
+#pragma once
+
+#include "xo/xo_types.h"
+#include "xo/utility/perfect_hash.h"
+#include <array>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/// declare the reflected fields of a struct, e.g. xo_reflect( my_struct, name, value, children );
+/// must be placed in the same namespace as the struct, up to 24 fields are supported
+#define xo_reflect( T, ... ) \
+inline constexpr auto xo_reflect_fields( const T* ) { \
+	return ::std::make_tuple( XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_CONCAT( XO_REFLECT_DETAIL_, XO_REFLECT_DETAIL_COUNT( __VA_ARGS__ ) )( T, __VA_ARGS__ ) ) ); }
+
+#define XO_REFLECT_DETAIL_EXPAND( x ) x
+#define XO_REFLECT_DETAIL_CONCAT_IMPL( a, b ) a##b
+#define XO_REFLECT_DETAIL_CONCAT( a, b ) XO_REFLECT_DETAIL_CONCAT_IMPL( a, b )
+#define XO_REFLECT_DETAIL_COUNT( ... ) XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_NTH( __VA_ARGS__, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 ) )
+#define XO_REFLECT_DETAIL_NTH( _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, N, ... ) N
+#define XO_REFLECT_DETAIL_FIELD( T, f ) ::xo::make_reflect_field( #f, &T::f )
+#define XO_REFLECT_DETAIL_1( T, f ) XO_REFLECT_DETAIL_FIELD( T, f )
+#define XO_REFLECT_DETAIL_2( T, f, ... ) XO_REFLECT_DETAIL_FIELD( T, f ), XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_1( T, __VA_ARGS__ ) )
+#define XO_REFLECT_DETAIL_3( T, f, ... ) XO_REFLECT_DETAIL_FIELD( T, f ), XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_2( T, __VA_ARGS__ ) )
+#define XO_REFLECT_DETAIL_4( T, f, ... ) XO_REFLECT_DETAIL_FIELD( T, f ), XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_3( T, __VA_ARGS__ ) )
+#define XO_REFLECT_DETAIL_5( T, f, ... ) XO_REFLECT_DETAIL_FIELD( T, f ), XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_4( T, __VA_ARGS__ ) )
+#define XO_REFLECT_DETAIL_6( T, f, ... ) XO_REFLECT_DETAIL_FIELD( T, f ), XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_5( T, __VA_ARGS__ ) )
+#define XO_REFLECT_DETAIL_7( T, f, ... ) XO_REFLECT_DETAIL_FIELD( T, f ), XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_6( T, __VA_ARGS__ ) )
+#define XO_REFLECT_DETAIL_8( T, f, ... ) XO_REFLECT_DETAIL_FIELD( T, f ), XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_7( T, __VA_ARGS__ ) )
+#define XO_REFLECT_DETAIL_9( T, f, ... ) XO_REFLECT_DETAIL_FIELD( T, f ), XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_8( T, __VA_ARGS__ ) )
+#define XO_REFLECT_DETAIL_10( T, f, ... ) XO_REFLECT_DETAIL_FIELD( T, f ), XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_9( T, __VA_ARGS__ ) )
+#define XO_REFLECT_DETAIL_11( T, f, ... ) XO_REFLECT_DETAIL_FIELD( T, f ), XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_10( T, __VA_ARGS__ ) )
+#define XO_REFLECT_DETAIL_12( T, f, ... ) XO_REFLECT_DETAIL_FIELD( T, f ), XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_11( T, __VA_ARGS__ ) )
+#define XO_REFLECT_DETAIL_13( T, f, ... ) XO_REFLECT_DETAIL_FIELD( T, f ), XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_12( T, __VA_ARGS__ ) )
+#define XO_REFLECT_DETAIL_14( T, f, ... ) XO_REFLECT_DETAIL_FIELD( T, f ), XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_13( T, __VA_ARGS__ ) )
+#define XO_REFLECT_DETAIL_15( T, f, ... ) XO_REFLECT_DETAIL_FIELD( T, f ), XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_14( T, __VA_ARGS__ ) )
+#define XO_REFLECT_DETAIL_16( T, f, ... ) XO_REFLECT_DETAIL_FIELD( T, f ), XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_15( T, __VA_ARGS__ ) )
+#define XO_REFLECT_DETAIL_17( T, f, ... ) XO_REFLECT_DETAIL_FIELD( T, f ), XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_16( T, __VA_ARGS__ ) )
+#define XO_REFLECT_DETAIL_18( T, f, ... ) XO_REFLECT_DETAIL_FIELD( T, f ), XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_17( T, __VA_ARGS__ ) )
+#define XO_REFLECT_DETAIL_19( T, f, ... ) XO_REFLECT_DETAIL_FIELD( T, f ), XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_18( T, __VA_ARGS__ ) )
+#define XO_REFLECT_DETAIL_20( T, f, ... ) XO_REFLECT_DETAIL_FIELD( T, f ), XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_19( T, __VA_ARGS__ ) )
+#define XO_REFLECT_DETAIL_21( T, f, ... ) XO_REFLECT_DETAIL_FIELD( T, f ), XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_20( T, __VA_ARGS__ ) )
+#define XO_REFLECT_DETAIL_22( T, f, ... ) XO_REFLECT_DETAIL_FIELD( T, f ), XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_21( T, __VA_ARGS__ ) )
+#define XO_REFLECT_DETAIL_23( T, f, ... ) XO_REFLECT_DETAIL_FIELD( T, f ), XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_22( T, __VA_ARGS__ ) )
+#define XO_REFLECT_DETAIL_24( T, f, ... ) XO_REFLECT_DETAIL_FIELD( T, f ), XO_REFLECT_DETAIL_EXPAND( XO_REFLECT_DETAIL_23( T, __VA_ARGS__ ) )
+
+namespace xo
+{
+	/// name and member pointer of a reflected field
+	template< typename S, typename M >
+	struct reflect_field
+	{
+		using struct_type = S;
+		using member_type = M;
+		std::string_view name;
+		M S::* member;
+	};
+
+	template< typename S, typename M >
+	constexpr reflect_field< S, M > make_reflect_field( const char* name, M S::* member ) { return { name, member }; }
+
+	/// check if a type has been declared with xo_reflect
+	template< typename T, typename = void > struct is_reflected : std::false_type {};
+	template< typename T > struct is_reflected< T, std::void_t< decltype( xo_reflect_fields( static_cast<const T*>( nullptr ) ) ) > > : std::true_type {};
+	template< typename T > constexpr bool is_reflected_v = is_reflected< T >::value;
+
+	/// tuple of reflect_field objects for type T
+	template< typename T > constexpr auto reflect_fields() { return xo_reflect_fields( static_cast<const T*>( nullptr ) ); }
+
+	/// number of reflected fields of T
+	template< typename T > constexpr size_t reflect_field_count() { return std::tuple_size_v< decltype( reflect_fields< T >() ) >; }
+
+	/// names of the reflected fields of T
+	template< typename T > constexpr auto reflect_field_names() {
+		return std::apply( []( auto... f ) { return std::array< std::string_view, sizeof...( f ) >{ f.name... }; }, reflect_fields< T >() );
+	}
+
+	/// compile-time perfect hash for the field names of T
+	template< typename T > inline constexpr perfect_hash< reflect_field_count< T >() > reflect_field_hash{ reflect_field_names< T >() };
+
+	/// call f( name, member ) for each reflected field of v
+	template< typename T, typename F > void for_each_field( T& v, F f ) {
+		std::apply( [&]( auto... fld ) { ( f( fld.name, v.*( fld.member ) ), ... ); }, reflect_fields< std::remove_const_t< T > >() );
+	}
+}
@@ -13,3 +13,6 @@
 
 /// macro to hide hideous SNFINAE syntax
 #define XO_ENABLE_IF_ENUM typename std::enable_if_t< std::is_enum<T>::value >* = nullptr
+
+/// macro to hide hideous SNFINAE syntax, used for std::string_view overloads that should not capture const char*
+#define XO_ENABLE_IF_STRING_VIEW typename std::enable_if_t< std::is_same<T, std::string_view>::value >* = nullptr
@@ -1,35 +1,56 @@
 #pragma once
 
-#include <cstring>
+#include "xo/utility/perfect_hash.h"
+#include <array>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <iostream>
 
 namespace smart_enum_detail
 {
-	constexpr const char* sep_chars = " ,\t\n\r";
-	template< typename E > bool from_str( const std::string& str, E& e, const char* va_args ) {
-		for ( int i = 0; *va_args; ++i ) {
-			size_t enum_len = std::strcspn( va_args, sep_chars );
-			if ( str.size() == enum_len && std::strncmp( str.c_str(), va_args, enum_len ) == 0 ) {
-				e = E( i ); return true;
-			}
-			size_t sep_len = std::strspn( va_args + enum_len, sep_chars );
-			va_args += enum_len + sep_len;
+	constexpr bool is_sep_char( char c ) { return c == ' ' || c == ',' || c == '\t' || c == '\n' || c == '\r'; }
+
+	/// count the names in a stringified __VA_ARGS__
+	constexpr size_t count_names( const char* va_args ) {
+		size_t n = 0;
+		for ( bool in_name = false; *va_args; ++va_args ) {
+			bool sep = is_sep_char( *va_args );
+			n += !sep && !in_name;
+			in_name = !sep;
 		}
-		return false;
-	} 
-	inline std::string to_str( int e, const char* va_args ) {
-		while ( e-- > 0 && *va_args ) {
-			va_args += std::strcspn( va_args, sep_chars );
-			va_args += std::strspn( va_args, sep_chars );
+		return n;
+	}
+
+	/// compile-time table of the names in a stringified __VA_ARGS__, with perfect hash lookup
+	template< size_t N > constexpr xo::perfect_hash< N > make_name_table( const char* va_args ) {
+		std::array< std::string_view, N > names{};
+		for ( size_t i = 0; i < N; ++i ) {
+			while ( is_sep_char( *va_args ) ) ++va_args;
+			size_t len = 0;
+			while ( va_args[ len ] && !is_sep_char( va_args[ len ] ) ) ++len;
+			names[ i ] = std::string_view( va_args, len );
+			va_args += len;
+		}
+		return xo::perfect_hash< N >( names );
+	}
+
+	template< typename E, size_t N > bool from_str( std::string_view str, E& e, const xo::perfect_hash< N >& names ) {
+		if ( auto idx = names.find( str ); idx != xo::no_index ) {
+			e = E( idx ); return true;
 		}
-		return std::string( va_args, std::strcspn( va_args, sep_chars ) );
+		return false;
+	}
+
+	template< size_t N > std::string to_str( int e, const xo::perfect_hash< N >& names ) {
+		return e >= 0 && size_t( e ) < N ? std::string( names.key( e ) ) : std::string();
 	}
 }
 
 #define XO_SMART_ENUM_DETAIL_DEFINE_FUNCTIONS( E, VA_STR ) \
-inline std::string to_str( E e ) { return ::smart_enum_detail::to_str( int( e ), VA_STR ); } \
-inline bool from_str( const std::string& str, E& e ) { return ::smart_enum_detail::from_str( str, e, VA_STR ); } \
+inline const auto& smart_enum_names( std::in_place_type_t< E > ) { static constexpr auto names = ::smart_enum_detail::make_name_table< ::smart_enum_detail::count_names( VA_STR ) >( VA_STR ); return names; } \
+inline std::string to_str( E e ) { return ::smart_enum_detail::to_str( int( e ), smart_enum_names( std::in_place_type< E > ) ); } \
+inline bool from_str( const std::string& str, E& e ) { return ::smart_enum_detail::from_str( str, e, smart_enum_names( std::in_place_type< E > ) ); } \
 inline std::ostream& operator<<( std::ostream& ostr, E e ) { return ostr << to_str( e ); } \
 inline std::istream& operator>>( std::istream& istr, E& e ) { std::string s; istr >> s; if ( istr.good() && !from_str( s, e ) ) istr.setstate( std::ios::failbit ); return istr; }
 
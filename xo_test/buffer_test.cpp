@@ -6,6 +6,26 @@
 #include "xo/container/circular_frame_buffer.h"
 #include "xo/container/circular_deque.h"
 #include "xo/container/storage.h"
+#include "xo/container/column_storage.h"
+#include "xo/container/chunked_storage.h"
+#include "xo/container/storage_file.h"
+#include "xo/container/storage_tools.h"
+#include "xo/container/storage_algorithms.h"
+#include "xo/numerical/filter.h"
+#include "xo/numerical/filter_design.h"
+#include "xo/numerical/random.h"
+#include "xo/thread/ring_buffer.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include "xo/geometry/quat.h"
+#include "xo/filesystem/filesystem.h"
+#include "xo/time/stopwatch.h"
+#include <fstream>
+#include <utility>
+#include "xo/utility/data_algorithms.h"
 #include "xo/system/test_case.h"
 #include "xo/string/string_tools.h"
 #include "xo/container/container_algorithms.h"
@@ -39,6 +59,41 @@ namespace xo
 			}
 		}
 
+		// power-of-two circular_deque with bulk access
+		circular_deque< int, true > pd( 5 );
+		XO_CHECK( pd.capacity() == 8 );
+		int values[ 12 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+		pd.push_back( values, 6 );
+		int out[ 12 ] = {};
+		XO_CHECK( pd.pop_front( out, 4 ) == 4 && out[ 3 ] == 3 && pd.front() == 4 );
+		pd.push_back( values + 6, 5 ); // wraps around
+		auto [s1, s2] = std::as_const( pd ).segments();
+		XO_CHECK( s1.size == 4 && s2.size == 3 && *s1.begin() == 4 && s2.data[ 2 ] == 10 && pd.back() == 10 );
+		pd.push_back( values, 12 ); // grows and re-linearizes
+		XO_CHECK( pd.capacity() == 32 && pd.size() == 19 && pd[ 6 ] == 10 && pd[ 7 ] == 0 && pd.segments().second.empty() );
+		int sum = 0;
+		for ( auto v : pd )
+			sum += v;
+		XO_CHECK( sum == 4 + 5 + 6 + 7 + 8 + 9 + 10 + 66 );
+
+		// empty bulk operations on a deque without capacity
+		circular_deque< int > zd;
+		zd.push_back( values, 0 );
+		XO_CHECK( zd.capacity() == 0 && zd.pop_front( out, 4 ) == 0 );
+		zd.push_back( values, 3 );
+		XO_CHECK( zd.size() == 3 && zd.back() == 2 );
+
+		// circular_frame_buffer segments
+		circular_frame_buffer< float, string, true > cfb( 2, 3 );
+		XO_CHECK( cfb.frame_capacity() == 4 );
+		for ( int f = 0; f < 6; ++f ) {
+			cfb.add_frame();
+			cfb[ 0 ] = float( f );
+			cfb[ 1 ] = float( 10 * f );
+		}
+		auto [f1, f2] = cfb.segments();
+		XO_CHECK( f1.size == 4 && f2.size == 4 && f1.data[ 0 ] == 2 && f2.data[ 3 ] == 50 && cfb( 5, 0 ) == 5 );
+
 		// regular buffer test
 		storage< float, string > buf( 0 );
 
@@ -46,4 +101,518 @@ namespace xo
 		for ( int i = 0; i < 10; ++i )
 			buf.add_channel( stringf( "channel%d", i ) );
 	}
+
+	XO_TEST_CASE( xo_column_storage_test )
+	{
+		column_storage< double > cs;
+		cs.add_channel( "a" );
+		cs.add_channel( "b", 1.0 );
+		for ( int i = 0; i < 100; ++i )
+		{
+			auto f = cs.add_frame();
+			f[ 0 ] = i;
+			f[ "b" ] = 2 * i;
+			if ( i == 50 )
+				cs.add_channel( "c", 3.0 );
+		}
+		XO_CHECK( cs.frame_size() == 100 && cs.channel_size() == 3 );
+		for ( index_t ci = 0; ci < cs.channel_size(); ++ci )
+			XO_CHECK( reinterpret_cast<std::uintptr_t>( cs.channel_data( ci ) ) % 64 == 0 );
+		XO_CHECK( cs( 10, 1 ) == 20 && cs[ 99 ][ "a" ] == 99 && cs( 10, 2 ) == 3.0 );
+		XO_CHECK( cs.get_interpolated_value( 10.5, 0 ) == 10.5 );
+
+		auto sto = make_storage( cs );
+		XO_CHECK( sto( 10, 1 ) == 20 && sto.get_label( 2 ) == "c" );
+		auto cs2 = make_column_storage( sto );
+		XO_CHECK( cs2.get_channel( "b" ) == cs.get_channel( "b" ) );
+		XO_CHECK( compute_channel_means( cs2 ) == compute_channel_means( sto ) );
+
+		// channels are aligned for types whose size does not divide the alignment
+		column_storage< vec3d > vcs( 5, 3 );
+		bool vec_aligned = true;
+		for ( index_t ci = 0; ci < vcs.channel_size(); ++ci )
+			vec_aligned &= reinterpret_cast<std::uintptr_t>( vcs.channel_data( ci ) ) % 64 == 0;
+		XO_CHECK( vec_aligned && vcs.frame_capacity() == 8 );
+	}
+
+	XO_TEST_CASE( xo_chunked_storage_test )
+	{
+		chunked_storage< float, string, 16 > cs;
+		cs.add_channel( "a" );
+		for ( int i = 0; i < 100; ++i )
+		{
+			cs.add_frame()[ 0 ] = float( i );
+			if ( i == 40 )
+			{
+				auto* first_chunk = cs.chunk_data( 0, 0 );
+				cs.add_channel( "b", 1.0f );
+				XO_CHECK( cs.chunk_data( 0, 0 ) == first_chunk );
+			}
+		}
+		XO_CHECK( cs.frame_size() == 100 && cs.chunk_count() == 7 );
+		XO_CHECK( cs( 99, 0 ) == 99.0f && cs[ 17 ][ "a" ] == 17.0f );
+		XO_CHECK( cs( 20, 1 ) == 1.0f && cs( 99, 1 ) == 0.0f );
+		XO_CHECK( cs.get_channel( "a" ).size() == 100 && cs.get_channel( "a" )[ 63 ] == 63.0f );
+		XO_CHECK( cs.get_interpolated_value( 15.5f, 0 ) == 15.5f );
+
+		auto sto = make_storage( cs );
+		XO_CHECK( sto.frame_size() == 100 && sto( 50, 0 ) == 50.0f && sto.get_label( 1 ) == "b" );
+	}
+
+	XO_TEST_CASE( xo_storage_file_test )
+	{
+		storage< double > sto;
+		sto.add_channel( "time" );
+		sto.add_channel( "value with spaces" );
+		for ( int i = 0; i < 100; ++i )
+			sto.add_frame( { 0.01 * i, double( i * i ) } );
+
+		auto bin_file = temp_directory_path() / "xo_storage_file_test.xosto";
+		auto txt_file = temp_directory_path() / "xo_storage_file_test.txt";
+		XO_CHECK( save_storage_binary( sto, bin_file ) );
+		{
+			mapped_storage< double > ms( bin_file );
+			XO_CHECK( ms.is_open() && ms.frame_size() == 100 && ms.channel_size() == 2 );
+			XO_CHECK( ms.get_label( 1 ) == "value with spaces" && ms.find_channel( "time" ) == 0 );
+			XO_CHECK( ms( 10, 1 ) == 100.0 && ms[ 99 ][ "time" ] == sto( 99, 0 ) );
+			XO_CHECK( reinterpret_cast<std::uintptr_t>( ms.channel_data( 1 ) ) % 64 == 0 );
+		}
+		auto sto2 = load_storage_binary< double >( bin_file );
+		XO_CHECK( sto2.data() == sto.data() );
+
+		error_code ec;
+		mapped_storage< float > wrong_type( bin_file, &ec );
+		XO_CHECK( !wrong_type.is_open() && ec.bad() );
+
+		// corrupt headers are rejected
+		auto check_corrupt = [&]( auto modify ) {
+			std::ifstream in( bin_file.str(), std::ios::binary );
+			std::string bytes( ( std::istreambuf_iterator< char >( in ) ), {} );
+			in.close();
+			storage_file_header h;
+			std::memcpy( &h, bytes.data(), sizeof( h ) );
+			modify( h );
+			std::memcpy( bytes.data(), &h, sizeof( h ) );
+			auto corrupt_file = temp_directory_path() / "xo_storage_file_test_corrupt.xosto";
+			std::ofstream( corrupt_file.str(), std::ios::binary ) << bytes;
+			error_code cec;
+			bool rejected = !mapped_storage< double >( corrupt_file, &cec ).is_open() && cec.bad();
+			remove( corrupt_file );
+			return rejected;
+		};
+		XO_CHECK( check_corrupt( []( storage_file_header& h ) { h.frame_count = h.frame_stride + 1; } ) );
+		XO_CHECK( check_corrupt( []( storage_file_header& h ) { h.labels_offset = 0; } ) );
+		XO_CHECK( check_corrupt( []( storage_file_header& h ) { h.labels_offset = h.data_offset + 64; } ) );
+		XO_CHECK( check_corrupt( []( storage_file_header& h ) { h.channel_count = uint64( 1 ) << 61; } ) );
+		XO_CHECK( check_corrupt( []( storage_file_header& h ) { h.data_offset = uint64( 1 ) << 62; } ) );
+		XO_CHECK( !check_corrupt( []( storage_file_header& ) {} ) );
+
+		std::ofstream( txt_file.str() ) << sto;
+		XO_CHECK( convert_storage_text_to_binary< double >( txt_file, bin_file ) );
+		XO_CHECK( convert_storage_binary_to_text< double >( bin_file, txt_file ) );
+		XO_CHECK( load_storage_binary< double >( bin_file ).get_channel( 0 ).size() == 100 );
+		remove( bin_file );
+		remove( txt_file );
+	}
+
+	XO_TEST_CASE_SKIP( xo_storage_file_performance )
+	{
+		storage< float > sto;
+		for ( int i = 0; i < 100; ++i )
+			sto.add_channel( stringf( "channel%d", i ) );
+		for ( int f = 0; f < 100000; ++f )
+		{
+			auto fr = sto.add_frame();
+			for ( index_t c = 0; c < sto.channel_size(); ++c )
+				fr[ c ] = float( f ) + 0.001f * c;
+		}
+
+		auto bin_file = temp_directory_path() / "xo_storage_file_performance.xosto";
+		auto txt_file = temp_directory_path() / "xo_storage_file_performance.txt";
+		stopwatch sw;
+		std::ofstream( txt_file.str() ) << sto;
+		sw.add_measure( "write_text" );
+		save_storage_binary( sto, bin_file );
+		sw.add_measure( "write_binary" );
+		storage< float > sto_txt;
+		std::ifstream( txt_file.str() ) >> sto_txt;
+		sw.add_measure( "read_text" );
+		auto sto_bin = load_storage_binary< float >( bin_file );
+		sw.add_measure( "read_binary" );
+		mapped_storage< float > ms( bin_file );
+		float sum = 0;
+		for ( index_t c = 0; c < ms.channel_size(); ++c )
+			sum += ms( ms.frame_size() - 1, c );
+		sw.add_measure( "map_binary" );
+		log::info( "Storage file performance (", sum, "):\n", sw.get_report() );
+		XO_CHECK( sto_bin.data() == sto.data() );
+		remove( bin_file );
+		remove( txt_file );
+	}
+
+	XO_TEST_CASE( xo_storage_channel_handles_test )
+	{
+		label_vector< string > lv;
+		XO_CHECK( lv.find_or_add( "a" ) == 0 && lv.find_or_add( "b" ) == 1 && lv.find_or_add( "a" ) == 0 );
+		XO_CHECK( lv.find_or_add( std::vector< string >{ "c", "b" } ) == std::vector< index_t >( { 2, 1 } ) );
+
+		storage< double > sto;
+		sto.add_channel( "time" );
+		sto.add_frame( 1.0 );
+		auto idx = sto.find_or_add_channels( { "a", "time", "b", "a" }, 5.0 );
+		XO_CHECK( idx == std::vector< index_t >( { 1, 0, 2, 1 } ) && sto.channel_size() == 3 );
+		XO_CHECK( sto( 0, 0 ) == 1.0 && sto( 0, 2 ) == 5.0 );
+
+		auto pos = find_or_add_vec3_channels( sto, "pos" );
+		auto ori = find_or_add_quat_channels( sto, "ori" );
+		XO_CHECK( pos.x == 3 && ori.z == 9 && sto.get_label( pos.z ) == "pos.z" );
+		for ( int i = 0; i < 10; ++i )
+		{
+			auto f = sto.add_frame();
+			write( f, pos, vec3d( i, 2 * i, 3 * i ) );
+			write( f, ori, quatd( 1, 0, 0, 0 ) );
+		}
+		vec3d v;
+		read( std::as_const( sto )[ 5 ], pos, v );
+		XO_CHECK( v == vec3d( 4, 8, 12 ) && sto[ 5 ][ "ori.w" ] == 1.0 );
+	}
+
+	XO_TEST_CASE( xo_storage_algorithms_test )
+	{
+		storage< double > sto;
+		sto.add_channel( "a" );
+		sto.add_channel( "b" );
+		for ( int i = 0; i < 1000; ++i )
+			sto.add_frame( { double( i ), double( i % 10 ) } );
+
+		thread_pool pool( 3 );
+		auto stats = compute_channel_statistics( sto, pool );
+		auto col_stats = compute_channel_statistics( make_column_storage( sto ), pool );
+		XO_CHECK( stats[ 0 ].mean == 499.5 && stats[ 0 ].min == 0 && stats[ 0 ].max == 999 );
+		XO_CHECK( std::abs( stats[ 1 ].mean - 4.5 ) < 1e-9 && std::abs( stats[ 1 ].std - std::sqrt( 8.25 ) ) < 1e-9 );
+		XO_CHECK( std::abs( col_stats[ 1 ].std - std::sqrt( 8.25 ) ) < 1e-9 && col_stats[ 1 ].max == 9 );
+
+		auto rs = resample( sto, 1999, pool );
+		XO_CHECK( rs.frame_size() == 1999 && rs.get_label( 1 ) == "b" );
+		XO_CHECK( rs( 1, 0 ) == 0.5 && rs( 1998, 0 ) == 999 );
+		auto crs = resample( make_column_storage( sto ), 1999, pool );
+		XO_CHECK( crs( 1, 0 ) == 0.5 && crs( 1998, 0 ) == 999 );
+		XO_CHECK( get_interpolated_values( sto, 0, std::vector< double >{ 1.5, 998.25 }, pool ) == std::vector< double >( { 1.5, 998.25 } ) );
+
+		auto filtered = sto;
+		auto lp = make_lowpass_butterworth_2nd_order( 0.1 );
+		filter_channels( filtered, lp, pool );
+		auto f = lp;
+		for ( index_t i = 0; i < sto.frame_size(); ++i )
+			XO_CHECK( filtered( i, 1 ) == f( sto( i, 1 ) ) );
+		auto col_filtered = make_column_storage( sto );
+		filter_channels( col_filtered, lp, pool );
+		XO_CHECK( col_filtered.get_channel( 1 ) == filtered.get_channel( 1 ) && col_filtered.get_channel( 0 ) == filtered.get_channel( 0 ) );
+
+		// filter bank gives the same results as individual filters
+		const size_t nc = 37;
+		std::vector< float > frames( 100 * nc ), out( frames.size() );
+		for ( auto& v : frames )
+			v = rand_uni( -1.0f, 1.0f );
+		auto lpf = make_lowpass_butterworth_2nd_order( 0.05f );
+		iir_filter_bank< float, 2 > bank( lpf, nc );
+		bank.process( frames.data(), out.data(), 100 );
+		bool equal_output = true;
+		for ( index_t c = 0; c < nc; ++c ) {
+			auto fc = lpf;
+			for ( index_t i = 0; i < 100; ++i )
+				equal_output &= out[ i * nc + c ] == fc( frames[ i * nc + c ] );
+		}
+		XO_CHECK( equal_output && bank.output( 5 ) == out[ 99 * nc + 5 ] );
+
+		// sos_filter_bank and zero-phase storage filtering give the same results as individual filters
+		auto sos = make_butterworth_filter< float >( 6, filter_pass::lowpass, 0.05 );
+		sos_filter_bank< float > sos_bank( sos, nc );
+		sos_bank.process( frames.data(), out.data(), 100 );
+		storage< float > zsto( 100 );
+		for ( index_t c = 0; c < nc; ++c )
+			zsto.add_channel( stringf( "channel%d", int( c ) ) );
+		std::copy( frames.begin(), frames.end(), &zsto( 0, 0 ) );
+		auto zcol = make_column_storage( zsto );
+		filter_channels_zero_phase( zsto, sos, pool );
+		filter_channels_zero_phase( zcol, sos, pool );
+		bool equal_sos = true, equal_zero_phase = true;
+		for ( index_t c = 0; c < nc; ++c ) {
+			auto fc = sos;
+			std::vector< float > ch( 100 );
+			for ( index_t i = 0; i < 100; ++i ) {
+				ch[ i ] = frames[ i * nc + c ];
+				equal_sos &= out[ i * nc + c ] == fc( ch[ i ] );
+			}
+			fc.process_zero_phase( ch.data(), ch.size() );
+			for ( index_t i = 0; i < 100; ++i )
+				equal_zero_phase &= zsto( i, c ) == ch[ i ] && zcol( i, c ) == ch[ i ];
+		}
+		XO_CHECK( equal_sos && equal_zero_phase );
+
+		// filter banks and filter_channels start with the state of a pre-warmed filter
+		auto warm_lp = lp;
+		auto warm_sos = make_butterworth_filter< double >( 4, filter_pass::lowpass, 0.1 );
+		for ( int i = 0; i < 10; ++i ) {
+			warm_lp( 1.0 + i );
+			warm_sos( 1.0 + i );
+		}
+		auto warm = sto, warm_sos_sto = sto;
+		auto col_warm = make_column_storage( sto );
+		filter_channels( warm, warm_lp, pool );
+		filter_channels( col_warm, warm_lp, pool );
+		filter_channels( warm_sos_sto, warm_sos, pool );
+		bool equal_warm = true;
+		for ( index_t c = 0; c < sto.channel_size(); ++c ) {
+			auto fc = warm_lp;
+			auto sc = warm_sos;
+			for ( index_t i = 0; i < sto.frame_size(); ++i ) {
+				const auto v = fc( sto( i, c ) );
+				equal_warm &= warm( i, c ) == v && col_warm( i, c ) == v && warm_sos_sto( i, c ) == sc( sto( i, c ) );
+			}
+		}
+		XO_CHECK( equal_warm && warm( 0, 0 ) != filtered( 0, 0 ) );
+	}
+
+	XO_TEST_CASE_SKIP( xo_storage_algorithms_performance )
+	{
+		storage< float > sto;
+		for ( int i = 0; i < 64; ++i )
+			sto.add_channel( stringf( "channel%d", i ) );
+		for ( int f = 0; f < 200000; ++f )
+		{
+			auto fr = sto.add_frame();
+			for ( index_t c = 0; c < sto.channel_size(); ++c )
+				fr[ c ] = float( ( f * 7 + c ) % 1000 );
+		}
+		auto cs = make_column_storage( sto );
+		thread_pool single( 0 );
+		float sum = 0;
+
+		stopwatch sw;
+		for ( index_t c = 0; c < sto.channel_size(); ++c )
+			sum += mean_std( sto.get_channel( c ) ).second;
+		sw.add_measure( "statistics_scalar" );
+		sum += compute_channel_statistics( sto, single )[ 0 ].std;
+		sw.add_measure( "statistics_storage_1" );
+		sum += compute_channel_statistics( sto )[ 0 ].std;
+		sw.add_measure( "statistics_storage_N" );
+		sum += compute_channel_statistics( cs, single )[ 0 ].std;
+		sw.add_measure( "statistics_column_1" );
+		sum += compute_channel_statistics( cs )[ 0 ].std;
+		sw.add_measure( "statistics_column_N" );
+
+		const size_t frames = 2 * sto.frame_size();
+		const float scale = float( sto.frame_size() - 1 ) / float( frames );
+		storage< float > rs( frames, sto.channel_size() );
+		for ( index_t f = 0; f < frames; ++f )
+			for ( index_t c = 0; c < sto.channel_size(); ++c )
+				rs( f, c ) = sto.get_interpolated_value( f * scale, c );
+		sw.add_measure( "resample_scalar" );
+		sum += resample( sto, frames, single )( 1, 1 );
+		sw.add_measure( "resample_storage_1" );
+		sum += resample( sto, frames )( 1, 1 );
+		sw.add_measure( "resample_storage_N" );
+		sum += resample( cs, frames )( 1, 1 );
+		sw.add_measure( "resample_column_N" );
+
+		auto lp = make_lowpass_butterworth_2nd_order( 0.1f );
+		for ( index_t c = 0; c < sto.channel_size(); ++c ) {
+			auto f = lp;
+			for ( index_t i = 0; i < sto.frame_size(); ++i )
+				sum += f( sto( i, c ) );
+		}
+		sw.add_measure( "filter_scalar" );
+		filter_channels( sto, lp, single );
+		sw.add_measure( "filter_storage_1" );
+		filter_channels( sto, lp );
+		sw.add_measure( "filter_storage_N" );
+		filter_channels( cs, lp );
+		sw.add_measure( "filter_column_N" );
+
+		auto sos = make_butterworth_filter< float >( 8, filter_pass::lowpass, 0.1 );
+		for ( index_t c = 0; c < sto.channel_size(); ++c ) {
+			auto f = sos;
+			for ( index_t i = 0; i < sto.frame_size(); ++i )
+				sum += f( sto( i, c ) );
+		}
+		sw.add_measure( "sos_filter_scalar" );
+		filter_channels( sto, sos, single );
+		sw.add_measure( "sos_filter_storage_1" );
+		filter_channels( sto, sos );
+		sw.add_measure( "sos_filter_storage_N" );
+		filter_channels( cs, sos );
+		sw.add_measure( "sos_filter_column_N" );
+		filter_channels_zero_phase( sto, sos );
+		sw.add_measure( "sos_zero_phase_storage_N" );
+		filter_channels_zero_phase( cs, sos );
+		sw.add_measure( "sos_zero_phase_column_N" );
+
+		log::info( "Storage algorithms performance (", sum + rs( 1, 1 ), ", ", global_thread_pool().size() + 1, " threads):\n", sw.get_report() );
+	}
+
+	XO_TEST_CASE( xo_thread_pool_test )
+	{
+		thread_pool pool( 2 );
+
+		// nested parallel_for from worker threads does not deadlock
+		std::atomic< size_t > count{ 0 };
+		pool.parallel_for( 0, 8, [&]( size_t b, size_t e ) {
+			for ( auto i = b; i < e; ++i )
+				pool.parallel_for( 0, 100, [&]( size_t b2, size_t e2 ) { count += e2 - b2; } );
+		} );
+		XO_CHECK( count == 800 );
+
+		// exceptions are rethrown after all blocks are done
+		std::atomic< int > finished{ 0 };
+		bool caught = false;
+		try {
+			pool.parallel_for( 0, 3, [&]( size_t b, size_t ) {
+				if ( b == 0 )
+					throw std::runtime_error( "block 0" );
+				std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+				++finished;
+			} );
+		}
+		catch ( std::runtime_error& ) { caught = true; }
+		XO_CHECK( caught && finished == 2 );
+	}
+
+	XO_TEST_CASE( xo_ring_buffer_test )
+	{
+		spsc_ring< int > sr( 5 );
+		XO_CHECK( sr.capacity() == 8 && sr.empty() );
+		int arr[ 10 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		XO_CHECK( sr.try_push( arr, 10 ) == 8 && !sr.try_push( 8 ) );
+		int v = -1;
+		XO_CHECK( sr.try_pop( v ) && v == 0 && sr.try_push( 8 ) );
+		int out[ 10 ] = {};
+		XO_CHECK( sr.try_pop( out, 10 ) == 8 && out[ 0 ] == 1 && out[ 7 ] == 8 && !sr.try_pop( v ) );
+
+		mpmc_ring< int > mr( 4 );
+		for ( int i = 0; i < 4; ++i )
+			XO_CHECK( mr.try_push( i ) );
+		XO_CHECK( !mr.try_push( 4 ) && mr.size() == 4 );
+		XO_CHECK( mr.try_pop( v ) && v == 0 );
+
+		// concurrent producers and consumers
+		const int n = 100000;
+		mpmc_ring< int > mq( 64 );
+		std::atomic< long long > sum = 0;
+		std::vector< std::thread > threads;
+		for ( int t = 0; t < 2; ++t ) {
+			threads.emplace_back( [&]() { for ( int i = 1; i <= n; ++i ) while ( !mq.try_push( i ) ) std::this_thread::yield(); } );
+			threads.emplace_back( [&]() { int x; for ( int i = 0; i < n; ++i ) { while ( !mq.try_pop( x ) ) std::this_thread::yield(); sum += x; } } );
+		}
+		for ( auto& t : threads )
+			t.join();
+		XO_CHECK( sum == 2ll * n * ( n + 1 ) / 2 && mq.empty() );
+
+		spsc_ring< int > sq( 64 );
+		long long ssum = 0;
+		std::thread consumer( [&]() { int x; for ( int i = 0; i < n; ++i ) { while ( !sq.try_pop( x ) ) std::this_thread::yield(); ssum += x; } } );
+		for ( int i = 1; i <= n; ++i )
+			while ( !sq.try_push( i ) ) std::this_thread::yield();
+		consumer.join();
+		XO_CHECK( ssum == 1ll * n * ( n + 1 ) / 2 );
+	}
+
+	XO_TEST_CASE_SKIP( xo_ring_buffer_performance )
+	{
+		const int n = 1000000;
+		const size_t capacity = 1024;
+		long long sum = 0;
+		auto spin = []() { std::this_thread::yield(); };
+		stopwatch sw;
+
+		// throughput: one producer, one consumer
+		{
+			std::mutex m;
+			circular_deque< int > cd( capacity );
+			std::thread consumer( [&]() {
+				for ( int i = 0; i < n; ) {
+					std::unique_lock lock( m );
+					if ( cd.empty() ) { lock.unlock(); spin(); continue; }
+					sum += cd.front(); cd.pop_front(); ++i;
+				}
+			} );
+			for ( int i = 0; i < n; ) {
+				std::unique_lock lock( m );
+				if ( cd.full() ) { lock.unlock(); spin(); continue; }
+				cd.push_back( i++ );
+			}
+			consumer.join();
+		}
+		sw.add_measure( "throughput_mutex_deque" );
+		{
+			spsc_ring< int > r( capacity );
+			std::thread consumer( [&]() { int x; for ( int i = 0; i < n; ++i ) { while ( !r.try_pop( x ) ) spin(); sum += x; } } );
+			for ( int i = 0; i < n; ++i )
+				while ( !r.try_push( i ) ) spin();
+			consumer.join();
+		}
+		sw.add_measure( "throughput_spsc" );
+		{
+			spsc_ring< int > r( capacity );
+			std::thread consumer( [&]() {
+				int buf[ 64 ];
+				for ( int i = 0; i < n; ) {
+					auto k = r.try_pop( buf, 64 );
+					if ( k == 0 ) spin();
+					for ( size_t j = 0; j < k; ++j ) sum += buf[ j ];
+					i += int( k );
+				}
+			} );
+			std::vector< int > data( 64 );
+			for ( int i = 0; i < n; ) {
+				for ( int j = 0; j < 64; ++j ) data[ j ] = i + j;
+				auto k = r.try_push( data.data(), std::min( 64, n - i ) );
+				if ( k == 0 ) spin();
+				i += int( k );
+			}
+			consumer.join();
+		}
+		sw.add_measure( "throughput_spsc_batch" );
+		{
+			mpmc_ring< int > r( capacity );
+			std::thread consumer( [&]() { int x; for ( int i = 0; i < n; ++i ) { while ( !r.try_pop( x ) ) spin(); sum += x; } } );
+			for ( int i = 0; i < n; ++i )
+				while ( !r.try_push( i ) ) spin();
+			consumer.join();
+		}
+		sw.add_measure( "throughput_mpmc" );
+
+		// latency: ping-pong round trips
+		const int trips = 100000;
+		{
+			std::mutex m;
+			circular_deque< int > ping( capacity ), pong( capacity );
+			auto pop = [&]( circular_deque< int >& q ) {
+				for ( ;; spin() ) {
+					std::scoped_lock lock( m );
+					if ( !q.empty() ) { int x = q.front(); q.pop_front(); return x; }
+				}
+			};
+			std::thread echo( [&]() { for ( int i = 0; i < trips; ++i ) { int x = pop( ping ); std::scoped_lock lock( m ); pong.push_back( x ); } } );
+			for ( int i = 0; i < trips; ++i ) {
+				{ std::scoped_lock lock( m ); ping.push_back( i ); }
+				sum += pop( pong );
+			}
+			echo.join();
+		}
+		sw.add_measure( "latency_mutex_deque" );
+		{
+			spsc_ring< int > ping( capacity ), pong( capacity );
+			std::thread echo( [&]() { int x; for ( int i = 0; i < trips; ++i ) { while ( !ping.try_pop( x ) ) spin(); pong.try_push( x ); } } );
+			int x;
+			for ( int i = 0; i < trips; ++i ) {
+				ping.try_push( i );
+				while ( !pong.try_pop( x ) ) spin();
+				sum += x;
+			}
+			echo.join();
+		}
+		sw.add_measure( "latency_spsc" );
+		log::info( "Ring buffer performance (", sum, "):\n", sw.get_report() );
+	}
 }
@@ -6,9 +6,22 @@
 #include "xo/numerical/random.h"
 #include "xo/system/test_case.h"
 #include "xo/container/container_algorithms.h"
+#include "xo/numerical/sliding_median.h"
 #include "xo/container/circular_frame_buffer.h"
 #include "xo/string/string_tools.h"
 #include "xo/container/flat_set.h"
+#include "xo/container/small_vector.h"
+#include "xo/container/eytzinger_map.h"
+#include "xo/container/hash_map.h"
+#include "xo/container/slot_map.h"
+#include "xo/container/handle_vector.h"
+#include "xo/geometry/dynmat.h"
+#include "xo/container/indexed_set.h"
+#include "xo/utility/memoize.h"
+#include <unordered_map>
+#include "xo/numerical/piecewise_linear_function.h"
+#include "xo/time/stopwatch.h"
+#include "xo/system/log.h"
 
 namespace xo
 {
@@ -119,6 +132,62 @@ namespace xo
 		std::vector<double> values{ 7.0, 4.0, 2.0, 3.0 };
 		XO_CHECK( average( values ) == 4.0 );
 		XO_CHECK( median( values ) == 3.5 );
+		XO_CHECK( quantile( values, 0.0 ) == 2.0 && quantile( values, 1.0 ) == 7.0 && quantile( values, 0.5 ) == 3.5 );
+		XO_CHECK( top_average( values, 2 ) == 2.5 && top_average( values, 10 ) == 4.0 );
+		XO_CHECK( ( quantiles( values, std::vector< double >{ 0.0, 0.5, 1.0 } ) == std::vector< double >{ 2.0, 3.5, 7.0 } ) );
+
+		// compare selection against sorting, with many duplicates and above the sampling threshold
+		std::vector< int > ints( 5001 );
+		for ( auto& v : ints )
+			v = rand_uni_int( 0, 100 );
+		auto sorted = sorted_copy( ints );
+		bool ok = true;
+		for ( index_t k : { index_t( 0 ), index_t( 1 ), index_t( 777 ), index_t( 2500 ), index_t( 5000 ) } ) {
+			auto v = ints;
+			select_nth( v.begin(), v.begin() + k, v.end() );
+			ok &= v[ k ] == sorted[ k ] && std::all_of( v.begin(), v.begin() + k, [&]( int x ) { return x <= v[ k ]; } )
+				&& std::all_of( v.begin() + k, v.end(), [&]( int x ) { return x >= v[ k ]; } );
+		}
+		XO_CHECK( ok && median( ints ) == sorted[ 2500 ] );
+		XO_CHECK( top_average( ints, 100 ) == average( sorted.begin(), sorted.begin() + 100 ) );
+
+		sliding_median< double > sm( 3 );
+		XO_CHECK( sm.add( 5.0 ) == 5.0 && sm.add( 1.0 ) == 3.0 && sm.add( 3.0 ) == 3.0 && sm.add( 9.0 ) == 3.0 && sm.add( 8.0 ) == 8.0 );
+		XO_CHECK( sm.size() == 3 && sm.window_size() == 3 );
+	}
+
+	XO_TEST_CASE_SKIP( xo_container_algorithms_performance )
+	{
+		std::vector< double > values( 1000000 );
+		for ( auto& v : values )
+			v = rand_uni< double >( 0.0, 1.0 );
+		double sum = 0.0;
+
+		stopwatch sw;
+		for ( int i = 0; i < 10; ++i ) {
+			auto v = values;
+			auto n = v.size(), h = n / 2;
+			std::nth_element( v.begin(), v.begin() + h, v.end() );
+			sum += ( v[ h ] + *std::max_element( v.begin(), v.begin() + h ) ) / 2;
+		}
+		sw.add_measure( "nth_element_median" );
+		for ( int i = 0; i < 10; ++i )
+			sum += median( values );
+		sw.add_measure( "select_median" );
+		for ( int i = 0; i < 10; ++i ) {
+			std::vector< double > result( 1000 );
+			std::partial_sort_copy( values.begin(), values.end(), result.begin(), result.end() );
+			sum += average( result );
+		}
+		sw.add_measure( "partial_sort_copy_top_average" );
+		for ( int i = 0; i < 10; ++i )
+			sum += top_average( values, 1000 );
+		sw.add_measure( "select_top_average" );
+		sliding_median< double > sm( 256 );
+		for ( auto v : values )
+			sum += sm.add( v );
+		sw.add_measure( "sliding_median_256" );
+		log::info( "container_algorithms performance (", sum, "):\n", sw.get_report() );
 	}
 
 	XO_TEST_CASE( xo_table )
@@ -133,4 +202,431 @@ namespace xo
 
 		XO_CHECK( t( "R1", "C1" ) == 1.0 );
 	}
+
+	XO_TEST_CASE( xo_small_vector )
+	{
+		small_vector< string, 4 > sv{ "a", "b", "c" };
+		XO_CHECK( sv.size() == 3 && sv.is_inline() && sv[ 2 ] == "c" );
+		sv.push_back( sv[ 0 ] );
+		sv.emplace_back( "e" ); // moves to heap
+		XO_CHECK( !sv.is_inline() && sv.size() == 5 && sv[ 3 ] == "a" && sv.back() == "e" );
+		sv.insert( sv.begin() + 1, "x" );
+		XO_CHECK( sv[ 1 ] == "x" && sv[ 2 ] == "b" && sv.size() == 6 );
+		sv.erase( sv.begin(), sv.begin() + 2 );
+		XO_CHECK( sv.front() == "b" && sv.size() == 4 );
+
+		auto sv2 = std::move( sv );
+		XO_CHECK( sv.empty() && sv.is_inline() && sv2.size() == 4 && sv2[ 3 ] == "e" );
+		small_vector< string, 4 > sv3( sv2.begin(), sv2.begin() + 2 );
+		auto sv4 = std::move( sv3 );
+		XO_CHECK( sv4.is_inline() && sv4[ 1 ] == "c" && sv3.empty() );
+		sv4 = sv2;
+		XO_CHECK( sv4 == sv2 );
+
+		small_vector< int, 8 > iv( 5, 1 );
+		iv.insert( iv.begin(), 0 );
+		iv.erase( iv.end() - 1 );
+		iv.resize( 10, 2 );
+		XO_CHECK( iv[ 0 ] == 0 && iv[ 5 ] == 2 && iv.size() == 10 && !iv.is_inline() );
+		XO_CHECK( ( small_vector< int, 2 >{ 1, 2, 3 } == small_vector< int, 8 >{ 1, 2, 3 } ) );
+	}
+
+	XO_TEST_CASE_SKIP( xo_small_vector_performance )
+	{
+		const int iterations = 1000000;
+		size_t sum = 0;
+		stopwatch sw;
+		for ( int i = 0; i < iterations; ++i )
+		{
+			std::vector< int > v;
+			for ( int j = 0; j < 1 + i % 8; ++j )
+				v.push_back( j );
+			sum += v.size();
+		}
+		sw.add_measure( "std_vector_int" );
+		for ( int i = 0; i < iterations; ++i )
+		{
+			small_vector< int, 8 > v;
+			for ( int j = 0; j < 1 + i % 8; ++j )
+				v.push_back( j );
+			sum += v.size();
+		}
+		sw.add_measure( "small_vector_int" );
+		for ( int i = 0; i < iterations; ++i )
+		{
+			std::vector< string > v;
+			for ( int j = 0; j < 1 + i % 4; ++j )
+				v.emplace_back( "abc" );
+			sum += v.size();
+		}
+		sw.add_measure( "std_vector_string" );
+		for ( int i = 0; i < iterations; ++i )
+		{
+			small_vector< string, 4 > v;
+			for ( int j = 0; j < 1 + i % 4; ++j )
+				v.emplace_back( "abc" );
+			sum += v.size();
+		}
+		sw.add_measure( "small_vector_string" );
+		log::info( "small_vector performance (", sum, "):\n", sw.get_report() );
+	}
+
+	XO_TEST_CASE( xo_flat_map_bulk_insert )
+	{
+		flat_map< int, string > fm{ { 3, "c" }, { 1, "a" }, { 3, "x" } };
+		XO_CHECK( fm.size() == 2 && fm[ 3 ] == "x" );
+		std::vector< pair< int, string > > items{ { 5, "e" }, { 2, "b" }, { 1, "y" }, { 5, "z" } };
+		fm.insert( items.begin(), items.end() );
+		XO_CHECK( fm.size() == 4 && fm[ 1 ] == "y" && fm[ 5 ] == "z" && fm.begin()->first == 1 && fm.back().first == 5 );
+		fm.insert( items.begin(), items.end(), duplicate_policy::keep_first );
+		XO_CHECK( fm.size() == 4 && fm[ 1 ] == "y" && fm[ 5 ] == "z" );
+		fm.insert_deferred( { 4, "d" } );
+		fm.insert_deferred( { 0, "0" } );
+		fm.insert_deferred( { 4, "dd" } );
+		fm.commit_deferred();
+		XO_CHECK( fm.size() == 6 && fm[ 4 ] == "dd" && fm.front().second == "0" );
+
+		flat_set< int > fs{ 4, 2, 4 };
+		std::vector< int > keys{ 9, 1, 2, 9 };
+		fs.insert( keys.begin(), keys.end() );
+		XO_CHECK( fs.size() == 4 && fs.front() == 1 && fs.back() == 9 );
+
+		sorted_vector< int > sv{ 3, 1 };
+		sv.insert( keys.begin(), keys.end() );
+		XO_CHECK( sv.size() == 6 && sv.front() == 1 && sv[ 1 ] == 1 && sv.back() == 9 );
+		sv.insert_deferred( 0 );
+		sv.commit_deferred( duplicate_policy::keep_first );
+		XO_CHECK( sv.size() == 5 && sv.front() == 0 );
+
+		piecewise_linear_function< double > plf;
+		std::vector< pair< double, double > > points{ { 1.0, 10.0 }, { 0.0, 0.0 } };
+		plf.insert_points( points.begin(), points.end() );
+		XO_CHECK( plf.size() == 2 && plf( 0.5 ) == 5.0 );
+	}
+
+	XO_TEST_CASE_SKIP( xo_flat_map_bulk_insert_performance )
+	{
+		const int n = 100000;
+		std::vector< pair< int, int > > items( n );
+		for ( int i = 0; i < n; ++i )
+			items[ i ] = { rand_uni_int( 0, 10 * n ), i };
+		size_t sum = 0;
+
+		stopwatch sw;
+		{
+			flat_map< int, int > fm;
+			for ( auto& kvp : items )
+				fm.insert( kvp );
+			sum += fm.size();
+		}
+		sw.add_measure( "flat_map_insert" );
+		{
+			flat_map< int, int > fm;
+			fm.insert( items.begin(), items.end() );
+			sum += fm.size();
+		}
+		sw.add_measure( "flat_map_bulk_insert" );
+		{
+			flat_map< int, int > fm;
+			for ( auto& kvp : items )
+				fm.insert_deferred( kvp );
+			fm.commit_deferred();
+			sum += fm.size();
+		}
+		sw.add_measure( "flat_map_deferred_insert" );
+		{
+			std::map< int, int > m;
+			for ( auto& kvp : items )
+				m.insert( kvp );
+			sum += m.size();
+		}
+		sw.add_measure( "std_map_insert" );
+		{
+			flat_set< int > fs;
+			for ( auto& kvp : items )
+				fs.insert( kvp.first );
+			sum += fs.size();
+		}
+		sw.add_measure( "flat_set_insert" );
+		{
+			flat_set< int > fs;
+			for ( auto& kvp : items )
+				fs.insert_deferred( kvp.first );
+			fs.commit_deferred();
+			sum += fs.size();
+		}
+		sw.add_measure( "flat_set_deferred_insert" );
+		{
+			sorted_vector< int > sv;
+			for ( auto& kvp : items )
+				sv.insert( kvp.first );
+			sum += sv.size();
+		}
+		sw.add_measure( "sorted_vector_insert" );
+		{
+			sorted_vector< int > sv;
+			for ( auto& kvp : items )
+				sv.insert_deferred( kvp.first );
+			sv.commit_deferred();
+			sum += sv.size();
+		}
+		sw.add_measure( "sorted_vector_deferred_insert" );
+		log::info( "flat_map bulk insert performance (", sum, "):\n", sw.get_report() );
+	}
+
+	XO_TEST_CASE( xo_eytzinger_map )
+	{
+		for ( int n = 0; n < 40; ++n )
+		{
+			flat_map< int, int > fm;
+			for ( int i = 0; i < n; ++i )
+				fm[ 2 * i ] = i;
+			auto em = eytzinger_map< int, int >::from_sorted( fm );
+			bool ok = em.size() == fm.size();
+			for ( int k = -1; k <= 2 * n; ++k ) {
+				ok &= ( em.lower_bound( k ) - em.begin() ) == ( fm.lower_bound( k ) - fm.begin() );
+				ok &= ( em.upper_bound( k ) - em.begin() ) == ( fm.upper_bound( k ) - fm.begin() );
+				ok &= em.contains( k ) == fm.contains( k );
+			}
+			XO_CHECK_MESSAGE( ok, stringf( "n=%d", n ) );
+		}
+
+		eytzinger_map< string, int > sm{ { "b", 2 }, { "a", 1 }, { "c", 3 }, { "a", 4 } };
+		XO_CHECK( sm.size() == 3 && sm[ "a" ] == 4 && sm.find( "d" ) == sm.end() && sm.begin()->first == "a" );
+		sm.at( "c" ) = 5;
+		XO_CHECK( sm[ "c" ] == 5 );
+	}
+
+	XO_TEST_CASE_SKIP( xo_eytzinger_map_performance )
+	{
+		const int lookups = 1000000;
+		size_t sum = 0;
+		stopwatch sw;
+		for ( int n = 100; n <= 1000000; n *= 10 )
+		{
+			flat_map< int, int > fm;
+			std::vector< pair< int, int > > items( n );
+			for ( int i = 0; i < n; ++i )
+				items[ i ] = { rand_uni_int( 0, 10 * n ), i };
+			fm.insert( items.begin(), items.end() );
+			auto em = eytzinger_map< int, int >::from_sorted( fm );
+			std::vector< int > keys( lookups );
+			for ( auto& k : keys )
+				k = rand_uni_int( 0, 10 * n );
+			sw.start();
+			for ( auto k : keys )
+				if ( auto it = fm.find( k ); it != fm.end() )
+					sum += it->second;
+			sw.add_measure( stringf( "flat_map_%d", n ) );
+			for ( auto k : keys )
+				if ( auto it = em.find( k ); it != em.end() )
+					sum += it->second;
+			sw.add_measure( stringf( "eytzinger_map_%d", n ) );
+		}
+		log::info( "eytzinger_map performance (", sum, "):\n", sw.get_report() );
+	}
+
+	XO_TEST_CASE( xo_hash_map )
+	{
+		hash_map< string, int > hm{ { "one", 1 }, { "two", 2 } };
+		XO_CHECK( hm.size() == 2 && hm.at( "one" ) == 1 && hm.contains( std::string_view( "two" ) ) && !hm.contains( "three" ) );
+		hm[ "three" ] = 3;
+		XO_CHECK( !hm.try_emplace( "three", 4 ).second && hm[ "three" ] == 3 );
+
+		hash_map< int, int > im;
+		for ( int i = 0; i < 10000; ++i )
+			im[ i * 7 ] = i;
+		for ( int i = 0; i < 10000; i += 2 )
+			im.erase( i * 7 );
+		bool ok = im.size() == 5000;
+		for ( int i = 0; i < 10000; ++i )
+			ok &= ( i % 2 == 1 ) ? im.at( i * 7 ) == i : !im.contains( i * 7 );
+		int sum = 0;
+		for ( const auto& [k, v] : std::as_const( im ) )
+			sum += v;
+		XO_CHECK( ok && sum == 25000000 );
+		auto im2 = im;
+		XO_CHECK( im2.size() == 5000 && im2.at( 7 ) == 1 );
+
+		// keys that share a hash cause an error instead of growing without bound, and the map stays intact
+		struct constant_hash { hash_t operator()( int ) const { return 42; } };
+		hash_map< int, int, constant_hash > ch;
+		bool overflow = false;
+		int inserted = 0;
+		try {
+			for ( ; inserted < 1000; ++inserted )
+				ch[ inserted ] = inserted;
+		}
+		catch ( std::exception& ) { overflow = true; }
+		bool intact = ch.size() == size_t( inserted );
+		for ( int i = 0; i < inserted; ++i )
+			intact &= ch.at( i ) == i;
+		XO_CHECK( overflow && inserted > 200 && ch.capacity() <= 8192 && intact );
+
+		indexed_set< string > is;
+		XO_CHECK( is.get_or_add( "a" ) == 0 && is.get_or_add( "b" ) == 1 && is.get_or_add( "a" ) == 0 && *is.try_get( "b" ) == 1 );
+
+		int calls = 0;
+		memoize< int( int, int ) > add( [&]( int a, int b ) { ++calls; return a + b; } );
+		XO_CHECK( add( 1, 2 ) == 3 && add( 1, 2 ) == 3 && add( 2, 1 ) == 3 && calls == 2 );
+	}
+
+	XO_TEST_CASE_SKIP( xo_hash_map_performance )
+	{
+		const int n = 100000;
+		std::vector< string > keys( n );
+		for ( auto& k : keys )
+			k = random_string( 12 );
+		size_t sum = 0;
+
+		stopwatch sw;
+		{
+			flat_map< string, index_t > m;
+			for ( index_t i = 0; i < n; ++i )
+				m.insert( { keys[ i ], i } );
+			for ( auto& k : keys )
+				sum += m.find( k )->second;
+		}
+		sw.add_measure( "flat_map" );
+		{
+			std::unordered_map< string, index_t > m;
+			for ( index_t i = 0; i < n; ++i )
+				m.try_emplace( keys[ i ], i );
+			for ( auto& k : keys )
+				sum += m.find( k )->second;
+		}
+		sw.add_measure( "std_unordered_map" );
+		{
+			hash_map< string, index_t > m;
+			for ( index_t i = 0; i < n; ++i )
+				m.try_emplace( keys[ i ], i );
+			for ( auto& k : keys )
+				sum += m.find( k )->second;
+		}
+		sw.add_measure( "hash_map" );
+		std::vector< int > int_keys( 10 * n );
+		for ( auto& k : int_keys )
+			k = rand_uni_int( 0, 1000000000 );
+		sw.start();
+		{
+			std::unordered_map< int, int > m;
+			for ( auto k : int_keys )
+				m[ k ] = k;
+			for ( auto k : int_keys )
+				sum += m.find( k )->second;
+		}
+		sw.add_measure( "std_unordered_map_int" );
+		{
+			hash_map< int, int > m;
+			for ( auto k : int_keys )
+				m[ k ] = k;
+			for ( auto k : int_keys )
+				sum += m.find( k )->second;
+		}
+		sw.add_measure( "hash_map_int" );
+		log::info( "hash_map performance (", sum, "):\n", sw.get_report() );
+	}
+
+	XO_TEST_CASE( xo_slot_map )
+	{
+		slot_map< string > sm;
+		auto a = sm.insert( "a" );
+		auto b = sm.insert( "b" );
+		auto c = sm.emplace( 1, 'c' );
+		XO_CHECK( sm.size() == 3 && sm[ a ] == "a" && sm[ b ] == "b" && sm.at( c ) == "c" );
+		XO_CHECK( sm.erase( a ) && !sm.erase( a ) && !sm.contains( a ) && sm.try_get( a ) == nullptr );
+		XO_CHECK( sm.size() == 2 && sm[ b ] == "b" && sm[ c ] == "c" );
+		auto d = sm.insert( "d" ); // reuses the slot of a with a new generation
+		XO_CHECK( d != a && !sm.contains( a ) && sm[ d ] == "d" && sm.handle_at( 2 ) == d );
+		XO_CHECK( !sm.contains( slot_map< string >::handle_type() ) );
+
+		slot_map< int, uint32 > im;
+		std::vector< handle< int, uint32 > > handles;
+		for ( int i = 0; i < 1000; ++i )
+			handles.push_back( im.insert( i ) );
+		for ( int i = 0; i < 1000; i += 3 )
+			im.erase( handles[ i ] );
+		bool ok = im.size() == 666;
+		for ( int i = 0; i < 1000; ++i )
+			ok &= ( i % 3 == 0 ) ? !im.contains( handles[ i ] ) : im[ handles[ i ] ] == i;
+		int sum = 0;
+		for ( auto v : im )
+			sum += v;
+		XO_CHECK( ok && sum == 499500 - 166833 );
+		im.clear();
+		XO_CHECK( im.empty() && !im.contains( handles[ 1 ] ) && im[ im.insert( 5 ) ] == 5 );
+	}
+
+	XO_TEST_CASE_SKIP( xo_slot_map_performance )
+	{
+		const int n = 20000, frames = 20, churn = 2000;
+		int64 sum = 0;
+
+		stopwatch sw;
+		{
+			handle_vector< int > hv;
+			for ( int i = 0; i < n; ++i )
+				hv.push_back( i );
+			for ( int f = 0; f < frames; ++f ) {
+				for ( int i = 0; i < churn; ++i )
+					hv.erase( hv.begin() + rand_uni_int( 0, int( hv.size() ) - 1 ) );
+				for ( int i = 0; i < churn; ++i )
+					hv.push_back( i );
+				for ( auto v : hv )
+					sum += v;
+			}
+		}
+		sw.add_measure( "handle_vector" );
+		{
+			slot_map< int, uint32 > sm;
+			std::vector< slot_map< int, uint32 >::handle_type > handles;
+			for ( int i = 0; i < n; ++i )
+				handles.push_back( sm.insert( i ) );
+			for ( int f = 0; f < frames; ++f ) {
+				for ( int i = 0; i < churn; ++i ) {
+					auto idx = rand_uni_int( 0, int( handles.size() ) - 1 );
+					sm.erase( handles[ idx ] );
+					handles[ idx ] = handles.back();
+					handles.pop_back();
+				}
+				for ( int i = 0; i < churn; ++i )
+					handles.push_back( sm.insert( i ) );
+				for ( auto v : sm )
+					sum += v;
+			}
+		}
+		sw.add_measure( "slot_map" );
+		log::info( "slot_map performance (", sum, "):\n", sw.get_report() );
+	}
+
+	XO_TEST_CASE( xo_dynarray )
+	{
+		dynarray< float, 64 > a( 5, 1.0f );
+		XO_CHECK( reinterpret_cast<uintptr_t>( a.data() ) % 64 == 0 && a.size() == 5 && a[ 4 ] == 1.0f );
+		a[ 0 ] = 2.0f;
+		a.resize( 8, 3.0f );
+		XO_CHECK( a.size() == 8 && a[ 0 ] == 2.0f && a[ 4 ] == 1.0f && a[ 7 ] == 3.0f );
+		a.resize( 2, default_init );
+		XO_CHECK( a.size() == 2 && a[ 0 ] == 2.0f );
+		auto b = a;
+		XO_CHECK( b == a && b.data() != a.data() );
+
+		dynarray< string > s( 2, "x" );
+		s.resize( 3, s[ 0 ] );
+		XO_CHECK( s[ 0 ] == "x" && s[ 2 ] == "x" );
+
+		dynarray< double, 64, true > h( 1 << 20, default_init );
+		h[ ( 1 << 20 ) - 1 ] = 1.0;
+		XO_CHECK( reinterpret_cast<uintptr_t>( h.data() ) % 4096 == 0 && h[ ( 1 << 20 ) - 1 ] == 1.0 );
+
+		dynvecd v1( 3, 1.0 ), v2( 3, 2.0 );
+		v1 += v2;
+		XO_CHECK( v1 == dynvecd( 3, 3.0 ) && dot_product( v1, v2 ) == 18.0 && !v1.is_null() && dynvecd( 2, 0.0 ).is_null() );
+		dynmat< double > m( 3, 2, 1.0 );
+		m( 2, 1 ) = 2.0;
+		auto mv = m * v2;
+		XO_CHECK( mv.size() == 2 && mv[ 0 ] == 6.0 && mv[ 1 ] == 8.0 );
+		m.resize( 2, 3 );
+		XO_CHECK( m.cols() == 2 && m.rows() == 3 && m( 1, 1 ) == 1.0 && m( 1, 2 ) == 0.0 );
+	}
 }
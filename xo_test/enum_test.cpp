@@ -5,6 +5,16 @@ namespace xo
 {
 	xo_smart_enum( fruit, apple, pear, banana );
 
+	xo_smart_enum_class( muscle,
+		gluteus_maximus_r, gluteus_medius_r, gluteus_minimus_r, iliopsoas_r, iliacus_r, psoas_r, adductor_longus_r, adductor_brevis_r,
+		adductor_magnus_r, gracilis_r, sartorius_r, tensor_fascia_latae_r, rectus_femoris_r, vastus_lateralis_r, vastus_medialis_r, vastus_intermedius_r,
+		biceps_femoris_long_r, biceps_femoris_short_r, semimembranosus_r, semitendinosus_r, gastrocnemius_medial_r, gastrocnemius_lateral_r, soleus_r, tibialis_anterior_r,
+		tibialis_posterior_r, peroneus_longus_r, peroneus_brevis_r, extensor_digitorum_r, flexor_digitorum_r, extensor_hallucis_r, flexor_hallucis_r, piriformis_r,
+		gluteus_maximus_l, gluteus_medius_l, gluteus_minimus_l, iliopsoas_l, iliacus_l, psoas_l, adductor_longus_l, adductor_brevis_l,
+		adductor_magnus_l, gracilis_l, sartorius_l, tensor_fascia_latae_l, rectus_femoris_l, vastus_lateralis_l, vastus_medialis_l, vastus_intermedius_l,
+		biceps_femoris_long_l, biceps_femoris_short_l, semimembranosus_l, semitendinosus_l, gastrocnemius_medial_l, gastrocnemius_lateral_l, soleus_l, tibialis_anterior_l,
+		tibialis_posterior_l, peroneus_longus_l, peroneus_brevis_l, extensor_digitorum_l, flexor_digitorum_l, extensor_hallucis_l, flexor_hallucis_l, piriformis_l );
+
 	XO_TEST_CASE( xo_enum_test )
 	{
 		fruit f = apple;
@@ -22,4 +32,19 @@ namespace xo
 		XO_CHECK( !from_str( "bananana", f ) );
 		XO_CHECK( f == apple );
 	}
+
+	XO_TEST_CASE( xo_enum_test_large )
+	{
+		const auto& names = smart_enum_names( std::in_place_type< muscle > );
+		XO_CHECK( names.size() == 64 );
+		bool round_trip = true;
+		for ( int i = 0; i < 64; ++i ) {
+			muscle m;
+			round_trip &= from_str( to_str( muscle( i ) ), m ) && m == muscle( i );
+		}
+		XO_CHECK( round_trip );
+		muscle m = muscle::psoas_r;
+		XO_CHECK( to_str( muscle::piriformis_l ) == "piriformis_l" );
+		XO_CHECK( !from_str( "psoas", m ) && !from_str( "psoas_r ", m ) && !from_str( "", m ) && m == muscle::psoas_r );
+	}
 }
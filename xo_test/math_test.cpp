@@ -10,6 +10,8 @@
 #include "xo/geometry/quat.h"
 #include "xo/geometry/vec3.h"
 #include "xo/numerical/math.h"
+#include "xo/numerical/average.h"
+#include "xo/numerical/filter_design.h"
 #include "xo/numerical/random.h"
 #include "xo/numerical/regression.h"
 #include "xo/numerical/regular_piecewise_linear_function.h"
@@ -19,6 +21,7 @@
 #include "xo/system/system_tools.h"
 #include "xo/system/test_case.h"
 #include "xo/time/timer.h"
+#include "xo/time/stopwatch.h"
 #include "xo/utility/irange.h"
 #include "xo/utility/optional.h"
 
@@ -36,6 +39,13 @@ namespace xo
 		bb += vec3f( 3, -2, 1 );
 		XO_CHECK( bb.lower_bounds == vec3f( -1, -2, -3 ) );
 		XO_CHECK( bb.upper_bounds == vec3f( 3, 2, 1 ) );
+
+		XO_CHECK( ceil_power_of_two( 0 ) == 1 && ceil_power_of_two( 5u ) == 8u && ceil_power_of_two( 64 ) == 64 );
+		XO_CHECK( ceil_power_of_two( size_t( 1 ) << 63 ) == size_t( 1 ) << 63 );
+		bool overflow_error = false;
+		try { ceil_power_of_two( ( size_t( 1 ) << 63 ) + 1 ); }
+		catch ( std::exception& ) { overflow_error = true; }
+		XO_CHECK( overflow_error );
 	}
 
 	XO_TEST_CASE( xo_optional_test )
@@ -158,6 +168,226 @@ namespace xo
 		XO_CHECK( equal( lg3( x2 ), -10.0 ) );
 	}
 
+	XO_TEST_CASE( xo_streaming_statistics_test )
+	{
+		const int n = 10000;
+		random_number_generator rng( 7 );
+		std::vector< double > x( n ), y( n );
+		for ( int i = 0; i < n; ++i ) {
+			x[ i ] = 1e6 + rng.uni( 0.0, 10.0 ); // large offset to test numerical stability
+			y[ i ] = 3.0 * x[ i ] - 5.0 + rng.norm( 0.0, 0.1 );
+		}
+
+		// two-pass reference
+		auto mean = average( x );
+		double var = 0.0;
+		for ( auto v : x )
+			var += squared( v - mean );
+		var /= n;
+
+		mean_varianced mv;
+		covarianced cov;
+		for ( int i = 0; i < n; ++i ) {
+			mv.add( x[ i ] );
+			cov.add( x[ i ], y[ i ] );
+		}
+		XO_CHECK( equal( mv.mean(), mean ) && std::abs( mv.variance() - var ) < 1e-6 * var );
+		auto lr1 = linear_regression( x, y );
+		auto lr2 = linear_regression( cov );
+		XO_CHECK( std::abs( lr1[ 1 ] - lr2[ 1 ] ) < 1e-8 && std::abs( lr1[ 0 ] - lr2[ 0 ] ) < 1e-2 );
+
+		// merge partial results from parallel chunks
+		std::vector< mean_varianced > mv_parts( 8 );
+		std::vector< covarianced > cov_parts( 8 );
+		global_thread_pool().parallel_for( 0, 8, [&]( size_t b, size_t e ) {
+			for ( auto c = b; c < e; ++c )
+				for ( size_t i = c * n / 8; i < ( c + 1 ) * n / 8; ++i ) {
+					mv_parts[ c ].add( x[ i ] );
+					cov_parts[ c ].add( x[ i ], y[ i ] );
+				}
+			} );
+		mean_varianced mv_merged;
+		covarianced cov_merged;
+		for ( int c = 0; c < 8; ++c ) {
+			mv_merged.merge( mv_parts[ c ] );
+			cov_merged.merge( cov_parts[ c ] );
+		}
+		XO_CHECK( mv_merged.weight() == n && equal( mv_merged.mean(), mean ) && std::abs( mv_merged.variance() - var ) < 1e-6 * var );
+		XO_CHECK( std::abs( cov_merged.slope() - cov.slope() ) < 1e-8 );
+
+		averaged a1, a2;
+		a1.add( 1.0 );
+		a2.add( 4.0, 2.0 );
+		a1.merge( a2 );
+		XO_CHECK( a1.get() == 3.0 );
+
+		// exponentially weighted: merging sequential chunks equals adding all values
+		ewm_varianced ew( 0.1 ), ew1( 0.1 ), ew2( 0.1 );
+		for ( int i = 0; i < 100; ++i ) {
+			ew.add( y[ i ] );
+			( i < 60 ? ew1 : ew2 ).add( y[ i ] );
+		}
+		ew1.merge( ew2 );
+		XO_CHECK( std::abs( ew1.mean() - ew.mean() ) < 1e-6 && std::abs( ew1.variance() - ew.variance() ) < 1e-6 * ew.variance() );
+
+		sliding_mean_varianced sw( 3 );
+		for ( double v : { 100.0, 1.0, 2.0, 3.0 } )
+			sw.add( v );
+		XO_CHECK( sw.size() == 3 && std::abs( sw.mean() - 2.0 ) < 1e-9 && std::abs( sw.variance() - 2.0 / 3.0 ) < 1e-9 );
+		for ( double v : { 4.0, 5.0, 6.0 } )
+			sw.add( v );
+		XO_CHECK( sw.mean() == 5.0 && sw.variance() == 2.0 / 3.0 ); // recomputed from the window
+	}
+
+	XO_TEST_CASE( xo_repeated_median_regression_test )
+	{
+		random_number_generator rng( 42 );
+		for ( int n : { 100, 501, 2000 } ) {
+			std::vector< double > x( n ), y( n );
+			for ( int i = 0; i < n; ++i ) {
+				x[ i ] = rng.uni( 0.0, 100.0 );
+				y[ i ] = 2.5 * x[ i ] + 4.0 + rng.norm( 0.0, 1.0 ) + ( i % 5 == 0 ? rng.uni( 0.0, 500.0 ) : 0.0 ); // 20% outliers
+			}
+			auto r1 = repeated_median_regression( x.begin(), x.end(), y.begin(), y.end() );
+			auto r2 = repeated_median_regression_parallel( x.begin(), x.end(), y.begin(), y.end() );
+			auto r3 = fast_repeated_median_regression( x.begin(), x.end(), y.begin(), y.end() );
+			XO_CHECK( r1[ 1 ] == r2[ 1 ] && r1[ 0 ] == r2[ 0 ] );
+			XO_CHECK_MESSAGE( std::abs( r1[ 1 ] - r3[ 1 ] ) < 0.01 && std::abs( r1[ 0 ] - r3[ 0 ] ) < 0.5, to_str( r3[ 1 ] ) );
+			XO_CHECK( std::abs( r3[ 1 ] - 2.5 ) < 0.1 );
+		}
+
+		// the slope is the low repeated median for any input size, also with duplicate x values
+		auto low_repeated_median = []( const std::vector< double >& x, const std::vector< double >& y ) {
+			const size_t n = x.size();
+			std::vector< double > sl, med;
+			for ( size_t i = 0; i < n; ++i ) {
+				sl.clear();
+				for ( size_t j = 0; j < n; ++j )
+					if ( j != i )
+						sl.push_back( ( y[ j ] - y[ i ] ) / ( x[ j ] - x[ i ] ) );
+				std::sort( sl.begin(), sl.end() );
+				med.push_back( sl[ ( n - 2 ) / 2 ] );
+			}
+			std::sort( med.begin(), med.end() );
+			return med[ ( n - 1 ) / 2 ];
+		};
+		for ( auto [ n, duplicates ] : { std::pair( 2, false ), std::pair( 10, false ), std::pair( 63, false ), std::pair( 64, false ), std::pair( 200, false ), std::pair( 100, true ) } ) {
+			std::vector< double > x( n ), y( n );
+			for ( int i = 0; i < n; ++i ) {
+				x[ i ] = duplicates ? i / 2 : i;
+				y[ i ] = 0.5 * i + rng.norm( 0.0, 1.0 );
+			}
+			auto rs = fast_repeated_median_regression( x.begin(), x.end(), y.begin(), y.end() );
+			XO_CHECK_MESSAGE( rs[ 1 ] == low_repeated_median( x, y ), to_str( n ) );
+		}
+
+		// collinear points, all slopes are equal
+		std::vector< float > x, y;
+		for ( int i = 0; i < 200; ++i ) {
+			x.push_back( float( i ) );
+			y.push_back( 2.5f * i + 4.0f );
+		}
+		auto r = fast_repeated_median_regression( x.begin(), x.end(), y.begin(), y.end() );
+		XO_CHECK( equal( r[ 1 ], 2.5f ) && equal( r[ 0 ], 4.0f ) );
+	}
+
+	XO_TEST_CASE_SKIP( xo_repeated_median_regression_performance )
+	{
+		const int n = 5000;
+		std::vector< double > x( n ), y( n );
+		for ( int i = 0; i < n; ++i ) {
+			x[ i ] = double( i );
+			y[ i ] = rand_norm( 2.0 * i, double( n ) / 10 );
+		}
+		double sum = 0.0;
+
+		stopwatch sw;
+		sum += repeated_median_regression( x.begin(), x.end(), y.begin(), y.end() )[ 1 ];
+		sw.add_measure( "repeated_median_regression" );
+		sum += repeated_median_regression_parallel( x.begin(), x.end(), y.begin(), y.end() )[ 1 ];
+		sw.add_measure( "repeated_median_regression_parallel" );
+		sum += fast_repeated_median_regression( x.begin(), x.end(), y.begin(), y.end() )[ 1 ];
+		sw.add_measure( "fast_repeated_median_regression" );
+		log::info( "repeated_median_regression performance (", sum, "):\n", sw.get_report() );
+	}
+
+	XO_TEST_CASE( xo_filter_design_test )
+	{
+		const double sqrt_half = std::sqrt( 0.5 );
+		auto near = []( double a, double b, double tol = 1e-6 ) { return std::abs( a - b ) < tol; };
+
+		// 2nd order butterworth is the same as make_lowpass_butterworth_2nd_order
+		auto bw2 = design_butterworth( 2, filter_pass::lowpass, 0.1 );
+		auto lp2 = make_lowpass_butterworth_2nd_order( 0.1 );
+		XO_CHECK( bw2.size() == 1 && near( bw2[ 0 ].b0, lp2.b0_, 1e-12 ) && near( bw2[ 0 ].b1, lp2.b_[ 0 ], 1e-12 ) && near( bw2[ 0 ].b2, lp2.b_[ 1 ], 1e-12 ) );
+		XO_CHECK( near( bw2[ 0 ].a1, -lp2.a_[ 0 ], 1e-12 ) && near( bw2[ 0 ].a2, -lp2.a_[ 1 ], 1e-12 ) );
+
+		auto lp = make_butterworth_filter< double >( 8, filter_pass::lowpass, 0.1 );
+		XO_CHECK( lp.section_size() == 4 && near( lp.magnitude_response( 0.0 ), 1.0 ) && near( lp.magnitude_response( 0.1 ), sqrt_half ) && lp.magnitude_response( 0.3 ) < 1e-4 );
+		auto hp = make_butterworth_filter< double >( 5, filter_pass::highpass, 0.2 );
+		XO_CHECK( hp.section_size() == 3 && near( hp.magnitude_response( 0.5 ), 1.0 ) && near( hp.magnitude_response( 0.2 ), sqrt_half ) && hp.magnitude_response( 0.02 ) < 1e-4 );
+		auto bp = make_butterworth_filter< double >( 4, filter_pass::bandpass, 0.1, 0.2 );
+		XO_CHECK( bp.section_size() == 4 && near( bp.magnitude_response( 0.1 ), sqrt_half ) && near( bp.magnitude_response( 0.2 ), sqrt_half ) );
+		XO_CHECK( bp.magnitude_response( 0.01 ) < 1e-4 && bp.magnitude_response( 0.45 ) < 1e-4 );
+
+		// chebyshev magnitude stays within the ripple band and is at its bottom at the cutoff frequency
+		const double ripple = std::pow( 10.0, -1.0 / 20.0 ); // 1dB
+		for ( int order : { 5, 6 } ) {
+			auto ch = make_chebyshev_filter< double >( order, 1.0, filter_pass::lowpass, 0.1 );
+			bool in_band = true;
+			for ( double f = 0.0; f < 0.1; f += 0.001 )
+				in_band &= ch.magnitude_response( f ) <= 1.0 + 1e-9 && ch.magnitude_response( f ) >= ripple - 1e-9;
+			XO_CHECK( in_band && near( ch.magnitude_response( 0.1 ), ripple ) && near( ch.magnitude_response( 0.0 ), order % 2 == 1 ? 1.0 : ripple ) );
+		}
+		auto chbp = make_chebyshev_filter< double >( 3, 0.5, filter_pass::bandpass, 0.05, 0.15 );
+		XO_CHECK( near( chbp.magnitude_response( 0.05 ), std::pow( 10.0, -0.5 / 20.0 ) ) && chbp.magnitude_response( 0.45 ) < 1e-3 );
+
+		// bessel filters have -3dB at the cutoff frequency and very little overshoot
+		for ( int order = 1; order <= 24; ++order ) {
+			auto be = make_bessel_filter< double >( order, filter_pass::lowpass, 0.05 );
+			XO_CHECK_MESSAGE( near( be.magnitude_response( 0.05 ), sqrt_half ) && near( be.magnitude_response( 0.0 ), 1.0 ), to_str( order ) );
+			auto bebp = make_bessel_filter< double >( order, filter_pass::bandpass, 0.1, 0.2 );
+			XO_CHECK_MESSAGE( near( bebp.magnitude_response( 0.1 ), sqrt_half ) && near( bebp.magnitude_response( 0.2 ), sqrt_half ), to_str( order ) );
+		}
+		bool order_error = false;
+		try { design_bessel( 25, filter_pass::lowpass, 0.1 ); }
+		catch ( std::exception& ) { order_error = true; }
+		XO_CHECK( order_error );
+		auto be4 = make_bessel_filter< double >( 4, filter_pass::lowpass, 0.05 );
+		auto bw4 = make_butterworth_filter< double >( 4, filter_pass::lowpass, 0.05 );
+		double be_max = 0.0, bw_max = 0.0;
+		for ( int i = 0; i < 200; ++i ) {
+			be_max = std::max( be_max, be4( 1.0 ) );
+			bw_max = std::max( bw_max, bw4( 1.0 ) );
+		}
+		XO_CHECK( be_max < 1.02 && bw_max > 1.1 );
+
+		// high-order sections are stable
+		bool stable = true;
+		for ( auto& s : design_chebyshev( 16, 0.1, filter_pass::bandpass, 0.01, 0.02 ) )
+			stable &= std::abs( s.a2 ) < 1.0 && std::abs( s.a1 ) < 1.0 + s.a2;
+		XO_CHECK( stable );
+
+		// zero-phase filtering of a slow sine leaves it unchanged, while forward filtering delays it
+		const size_t n = 1000;
+		std::vector< double > x( n ), y, z( n );
+		for ( size_t i = 0; i < n; ++i )
+			x[ i ] = std::sin( 2 * constantsd::pi() * 0.01 * i );
+		y = x;
+		auto zp = make_butterworth_filter< double >( 6, filter_pass::lowpass, 0.05 );
+		zp.process_zero_phase( y.data(), n );
+		zp.reset();
+		zp.process( x.data(), z.data(), n );
+		double max_err = 0.0, max_edge_err = 0.0, max_delay_err = 0.0;
+		for ( size_t i = 0; i < n; ++i ) {
+			// edges have small transients, because the signal is only extended by a few samples
+			auto& err = i >= 100 && i < n - 100 ? max_err : max_edge_err;
+			err = std::max( err, std::abs( y[ i ] - x[ i ] ) );
+			if ( i >= 100 ) max_delay_err = std::max( max_delay_err, std::abs( z[ i ] - x[ i ] ) );
+		}
+		XO_CHECK_MESSAGE( max_err < 1e-5 && max_edge_err < 0.05 && max_delay_err > 0.1, to_str( max_err ) );
+	}
+
 #if 0
 	void vec_quat_test()
 	{
@@ -5,6 +5,9 @@
 #include "xo/system/log.h"
 #include "xo/utility/smart_enum.h"
 #include "xo/serialization/prop_node_serializer_zml.h"
+#include "xo/serialization/prop_node_serializer_ini.h"
+#include "xo/serialization/prop_node_serializer_json.h"
+#include "xo/serialization/serialize_struct.h"
 #include "xo/string/string_tools.h"
 #include <sstream>
 
@@ -58,4 +61,134 @@ namespace xo
 			log::info( p2 );
 		}
 	}
+
+	XO_TEST_CASE( xo_serializer_ini_test )
+	{
+		string long_value( 5000, 'x' );
+		std::stringstream str;
+		str << "; comment\r\nmain = 1\n\n[group1]\nkey1 = value1\nkey2=" << long_value << "\r\nkey1 = value3\n[group2]\nkey1=value4";
+
+		prop_node pn;
+		prop_node_serializer_ini( pn ).read_stream( str );
+		XO_CHECK( pn.size() == 3 );
+		XO_CHECK( pn.get<int>( "main" ) == 1 );
+		XO_CHECK( pn[ "group1" ].size() == 2 );
+		XO_CHECK( pn[ "group1" ].get<string>( "key1" ) == "value3" );
+		XO_CHECK( pn[ "group1" ].get<string>( "key2" ) == long_value );
+		XO_CHECK( pn[ "group2" ].get<string>( "key1" ) == "value4" );
+
+		std::stringstream str2;
+		prop_node_serializer_ini( pn ).write_stream( str2 );
+		prop_node pn2;
+		prop_node_serializer_ini( pn2 ).read_stream( str2 );
+		XO_CHECK( pn == pn2 );
+	}
+
+	XO_TEST_CASE( xo_serializer_json_test )
+	{
+		auto pn = parse_json( R"({ "a": 1.5, "b": [ 1, -2, 3e4, 0.5 ], "c": { "d": "t\"ext\u00e9", "e": [ true, null, [ 1 ], { "f": 2 } ] } })" );
+		XO_CHECK( pn.get<double>( "a" ) == 1.5 );
+		XO_CHECK( pn[ "b" ].size() == 4 );
+		XO_CHECK( pn[ "b" ].get<double>( 2 ) == 3e4 );
+		XO_CHECK( pn[ "c" ].get<string>( "d" ) == "t\"ext\xc3\xa9" );
+		XO_CHECK( pn[ "c" ][ "e" ].get<bool>( 0 ) == true );
+		XO_CHECK( !pn[ "c" ][ "e" ][ 1 ].has_value() );
+		XO_CHECK( pn[ "c" ][ "e" ][ 3 ].get<int>( "f" ) == 2 );
+
+		prop_node p1 = example_prop_node();
+		prop_node p2;
+		std::stringstream str;
+		prop_node_serializer_json( p1 ).write_stream( str );
+		prop_node_serializer_json( p2 ).read_stream( str );
+		XO_CHECK( p1 == p2 );
+
+		error_code ec;
+		parse_json( "{ \"a\": [ 1, 2 }", &ec );
+		XO_CHECK( ec.bad() );
+
+		// unicode escapes are exactly four digits, unpaired surrogates are replaced
+		XO_CHECK( parse_json( R"("\u00e9face")" ).get<string>() == "\xc3\xa9" "face" );
+		XO_CHECK( parse_json( R"("\ud83d\ude00")" ).get<string>() == "\xf0\x9f\x98\x80" );
+		XO_CHECK( parse_json( R"("\ud83dx\ude00")" ).get<string>() == "\xef\xbf\xbdx\xef\xbf\xbd" );
+		error_code ec2;
+		parse_json( R"("\u00e")", &ec2 );
+		XO_CHECK( ec2.bad() );
+
+		// empty arrays and objects are nodes without value, strings that look like them stay strings
+		auto pe = parse_json( R"({ "a": [], "b": {}, "c": null, "d": "[]", "e": "{}" })" );
+		XO_CHECK( pe[ "a" ].empty() && pe[ "b" ].empty() && pe[ "c" ].empty() && pe.get<string>( "d" ) == "[]" );
+		std::stringstream str2;
+		prop_node_serializer_json( pe ).write_stream( str2 );
+		prop_node pe2;
+		prop_node_serializer_json( pe2 ).read_stream( str2 );
+		XO_CHECK( pe == pe2 && str2.str().find( "\"a\": null" ) != string::npos && str2.str().find( "\"[]\"" ) != string::npos && str2.str().find( "\"{}\"" ) != string::npos );
+	}
+
+	struct reflect_test_child
+	{
+		int id = 0;
+		string name;
+		bool operator==( const reflect_test_child& o ) const { return id == o.id && name == o.name; }
+	};
+	xo_reflect( reflect_test_child, id, name );
+
+	struct reflect_test_struct
+	{
+		double value = 0;
+		string name;
+		enumclass e = enumclass::value1;
+		std::vector< double > numbers;
+		reflect_test_child child;
+		std::vector< reflect_test_child > children;
+		bool operator==( const reflect_test_struct& o ) const {
+			return value == o.value && name == o.name && e == o.e && numbers == o.numbers && child == o.child && children == o.children;
+		}
+	};
+	xo_reflect( reflect_test_struct, value, name, e, numbers, child, children );
+
+	XO_TEST_CASE( xo_reflection_test )
+	{
+		static_assert( reflect_field_count< reflect_test_struct >() == 6 );
+		static_assert( reflect_field_hash< reflect_test_struct >.find( "numbers" ) == 3 );
+		static_assert( reflect_field_hash< reflect_test_struct >.find( "unknown" ) == no_index );
+
+		reflect_test_struct expected{ 1.5, "hello world", enumclass::value3, { 1, 2, 3 }, { 7, "seven" }, { { 1, "one" }, { 2, "two" } } };
+
+		reflect_test_struct v1;
+		zml_struct_reader zr( R"(value = 1.5 unused { a = 1 b = [ 2 3 ] } name = "hello world" e = value3
+			numbers = [ 1 2 3 ] child { id = 7 name = seven } children = [ { id = 1 name = one } { id = 2 name = two } ])" );
+		XO_CHECK( read_struct( zr, v1 ) );
+		XO_CHECK( v1 == expected );
+
+		reflect_test_struct v2;
+		json_struct_reader jr( R"({ "value": 1.5, "name": "hello world", "unused": { "a": [ 1, "]" ] }, "e": "value3",
+			"numbers": [ 1, 2, 3 ], "child": { "id": 7, "name": "seven" }, "children": [ { "id": 1, "name": "one" }, { "id": 2, "name": "two" } ] })" );
+		XO_CHECK( read_struct( jr, v2 ) );
+		XO_CHECK( v2 == expected );
+
+		std::stringstream str;
+		write_struct_binary( str, expected );
+		reflect_test_struct v3;
+		XO_CHECK( read_struct_binary( str, v3 ) );
+		XO_CHECK( v3 == expected );
+
+		// corrupt sizes fail without allocating the claimed size
+		std::stringstream corrupt;
+		const std::uint32_t huge_size = 0xfffffff0;
+		corrupt.write( reinterpret_cast<const char*>( &huge_size ), sizeof( huge_size ) );
+		corrupt.write( "abcd", 4 );
+		std::vector< double > huge_vec;
+		XO_CHECK( !read_struct_binary( corrupt, huge_vec ) && huge_vec.capacity() < 1000000 );
+
+		// root level arrays are read with brackets, root level objects without braces
+		std::vector< reflect_test_child > root_children;
+		zml_struct_reader zr2( "[ { id = 1 name = one } { id = 2 name = two } ]" );
+		XO_CHECK( read_struct( zr2, root_children ) && root_children == expected.children );
+
+		error_code ec;
+		reflect_test_struct v4;
+		json_struct_reader jr2( R"({ "value": "abc" })", &ec );
+		XO_CHECK( !read_struct( jr2, v4 ) );
+		XO_CHECK( ec.bad() );
+	}
 }
@@ -1,5 +1,9 @@
 #include "xo/xo_types.h"
 #include "xo/string/string_tools.h"
+#include "xo/string/pattern_matcher.h"
+#include "xo/string/fixed_string.h"
+#include "xo/string/stack_string.h"
+#include "xo/string/string_builder.h"
 #include "xo/system/test_case.h"
 #include "xo/filesystem/path.h"
 #include "xo/string/dictionary.h"
@@ -19,6 +23,19 @@ namespace xo
 		XO_CHECK( fruit_dict( "banaan", no_fruit ) == banaan );
 		XO_CHECK( fruit_dict( "peerr", no_fruit ) == no_fruit );
 
+		constexpr auto static_fruit_dict = make_static_dictionary< fruit >( { { appel, "appel" }, { peer, "peer" }, { banaan, "banaan" } } );
+		static_assert( static_fruit_dict( "peer", no_fruit ) == peer );
+		static_assert( static_fruit_dict( banaan ) == "banaan" && static_fruit_dict( appel ) == "appel" && static_fruit_dict( peer ) == "peer" );
+		auto reverse_dict = xo::dictionary< fruit >( { { banaan, "banaan" }, { appel, "appel" }, { peer, "peer" } } );
+		XO_CHECK( reverse_dict( appel ) == "appel" && reverse_dict( peer ) == "peer" && reverse_dict( banaan ) == "banaan" );
+		bool missing_error = false;
+		try { reverse_dict( no_fruit ); }
+		catch ( std::exception& ) { missing_error = true; }
+		XO_CHECK( missing_error );
+		XO_CHECK( static_fruit_dict( string( "appel" ) ) == appel );
+		XO_CHECK( static_fruit_dict( "peerr", no_fruit ) == no_fruit );
+		XO_CHECK( lookup( "banaan", static_fruit_dict ) == banaan );
+
 		for ( int f = appel; f < fruit_count; ++f )
 		{
 			switch ( hash( fruit_dict( fruit( f ) ) ) )
@@ -98,4 +115,92 @@ namespace xo
 		std::stringstream str;
 		str << fr;
 	}
+
+	XO_TEST_CASE( xo_string_view_tools )
+	{
+		std::string_view s = "  key = some value\t";
+		XO_CHECK( trim_str( s ) == "key = some value" );
+		XO_CHECK( trim_left_str( s ) == "key = some value\t" );
+		XO_CHECK( trim_right_str( s ) == "  key = some value" );
+		XO_CHECK( left_str( trim_str( s ), 3 ) == "key" );
+		XO_CHECK( left_str( trim_str( s ), -6 ) == "key = some" );
+		XO_CHECK( right_str( trim_str( s ), 5 ) == "value" );
+		XO_CHECK( mid_str( trim_str( s ), 6, 4 ) == "some" );
+
+		auto [key, value] = make_key_value_str( s );
+		XO_CHECK( key == "key" && value == "some value" );
+		auto [first, rest] = split_str_at_first( std::string_view( "a.b.c" ), "." );
+		XO_CHECK( first == "a" && rest == "b.c" );
+		auto [head, last] = split_str_at_last( std::string_view( "a.b.c" ), "." );
+		XO_CHECK( head == "a.b" && last == "c" );
+
+		auto vs = split_str( std::string_view( "appel; peer,,, banaan" ), ";., " );
+		XO_CHECK( vs.size() == 3 && vs[ 0 ] == "appel" && vs[ 1 ] == "peer" && vs[ 2 ] == "banaan" );
+
+		int count = 0;
+		for ( auto v : split_str_range( ",,one,two,,three,", "," ) )
+			XO_CHECK( !v.empty() && ++count > 0 );
+		XO_CHECK( count == 3 );
+		XO_CHECK( split_str_range( ",,,", "," ).begin() == split_str_range( ",,,", "," ).end() );
+	}
+
+	XO_TEST_CASE( xo_pattern_matcher_test )
+	{
+		std::vector< string > names = { "", "a", "abc", "abcabc", "joint.angle", "joint.velocity", "muscle_l.force", "muscle_r.force", "x?y", "aaab" };
+		std::vector< string > patterns = { "*", "a", "a*", "*c", "a*c", "*abc*", "joint.*", "muscle_?.force", "*.*", "a?c", "**b", "*a*a*b", "x?y", "[am]*" };
+		for ( auto& p : patterns )
+		{
+			pattern_matcher pm( p );
+			for ( auto& n : names )
+				XO_CHECK_MESSAGE( pm( n ) == pattern_match( n, p ), p + " " + n );
+		}
+
+		// case sensitivity is the same as pattern_match(), which is case-insensitive on MSVC
+		for ( string n : { "ABC", "Joint.Angle", "MUSCLE_L.FORCE" } )
+			for ( auto& p : patterns )
+				XO_CHECK_MESSAGE( pattern_matcher( p )( n ) == pattern_match( n, p ), p + " " + n );
+
+		pattern_matcher pm( "joint.*;*.force;a?c" );
+		auto flags = pm.match_all( names );
+		XO_CHECK( flags == std::vector< bool >( { false, false, true, false, true, true, true, true, false, false } ) );
+		XO_CHECK( !pattern_matcher().match( "a" ) );
+
+		string long_pattern;
+		for ( int i = 0; i < 200; ++i )
+			long_pattern += stringf( "name%d_*;", i );
+		pattern_matcher pm2( long_pattern );
+		XO_CHECK( pm2( "name199_x" ) && pm2( "name0_" ) && !pm2( "name200_x" ) );
+	}
+
+	XO_TEST_CASE( xo_string_builder_test )
+	{
+		fixed_string< 8 > fs( "abc" );
+		fs.appendf( "%d", 12 );
+		XO_CHECK( fs == "abc12" );
+		fs += "defgh";
+		XO_CHECK( fs == "abc12def" && fs.full() );
+
+		string_builder sb;
+		sb.appendf( "%s=%d", "value", 42 );
+		sb += ' ';
+		XO_CHECK( sb == "value=42 " && sb.is_inline() );
+		string long_str( 1000, 'x' );
+		sb.appendf( "%s", long_str.c_str() );
+		XO_CHECK( sb.size() == 1009 && !sb.is_inline() && sb.view().substr( 9 ) == long_str );
+		string_builder sb2( std::move( sb ) );
+		XO_CHECK( sb2.size() == 1009 && sb.empty() );
+		XO_CHECK( stringf( "%s", long_str.c_str() ) == long_str );
+
+		stack_string ss;
+		ss.set( "root" );
+		ss.push_back( ".child" );
+		for ( int i = 0; i < 20; ++i )
+			ss.push_back( ".x" );
+		for ( int i = 0; i < 20; ++i )
+			ss.pop_back();
+		XO_CHECK( ss.view() == "root.child" );
+		const char* root_ptr = ss.str().c_str();
+		ss.pop_back();
+		XO_CHECK( ss.str() == "root" && ss.str().c_str() == root_ptr ); // capacity is kept when popping
+	}
 }